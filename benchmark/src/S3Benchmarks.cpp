@@ -0,0 +1,364 @@
+/**
+ * @file S3Benchmarks.cpp
+ *
+ * This module contains the benchmarks of the Aws::S3 class, measuring the
+ * overhead of the client itself (worker threads, signing, parsing, and
+ * so on) apart from any network effects.  Requests are answered at once
+ * by a stand-in HTTP client with canned responses of a configurable
+ * size.
+ *
+ * For each operation, besides the time per operation and operations per
+ * second, the 50th and 99th percentile latencies and the number of heap
+ * allocations per operation are reported.  The allocation count includes
+ * the copy of the canned response made by the stand-in HTTP client.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <Aws/Config.hpp>
+#include <Aws/S3.hpp>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <functional>
+#include <Http/IClient.hpp>
+#include <memory>
+#include <new>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * This counts the heap allocations made by the whole program.
+     */
+    std::atomic< size_t > numAllocations{0};
+
+}
+
+void* operator new(size_t size) {
+    ++numAllocations;
+    const auto memory = malloc((size == 0) ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+namespace {
+
+    /**
+     * This is a transaction which is already complete when it's handed
+     * back by the stand-in HTTP client.
+     */
+    struct CannedTransaction
+        : public Http::IClient::Transaction
+    {
+        // Http::IClient::Transaction
+
+        virtual bool AwaitCompletion(
+            const std::chrono::milliseconds& relativeTime
+        ) override {
+            return true;
+        }
+
+        virtual void AwaitCompletion() override {
+        }
+
+        virtual void SetCompletionDelegate(
+            std::function< void() > completionDelegate
+        ) override {
+            completionDelegate();
+        }
+    };
+
+    /**
+     * This stands in for an HTTP client, answering every request at once
+     * with the same canned response.
+     */
+    struct CannedHttpClient
+        : public Http::IClient
+    {
+        // Properties
+
+        /**
+         * This is the response to give to every request.
+         */
+        Http::Response response;
+
+        // Http::IClient
+
+        virtual SystemAbstractions::DiagnosticsSender::UnsubscribeDelegate SubscribeToDiagnostics(
+            SystemAbstractions::DiagnosticsSender::DiagnosticMessageDelegate delegate,
+            size_t minLevel = 0
+        ) override {
+            return []{};
+        }
+
+        virtual std::shared_ptr< Http::IClient::Transaction > Request(
+            Http::Request request,
+            bool persistConnection = true,
+            UpgradeDelegate upgradeDelegate = nullptr
+        ) override {
+            const auto transaction = std::make_shared< CannedTransaction >();
+            transaction->state = Http::IClient::Transaction::State::Completed;
+            transaction->response = response;
+            return transaction;
+        }
+    };
+
+    /**
+     * Make an S3 client which sends its requests to a stand-in HTTP
+     * client giving the given canned response.
+     *
+     * @param[in] response
+     *     This is the response to give to every request.
+     *
+     * @return
+     *     The S3 client is returned.
+     */
+    Aws::S3 MakeS3(const Http::Response& response) {
+        const auto http = std::make_shared< CannedHttpClient >();
+        http->response = response;
+        Aws::Config config;
+        config.region = "us-east-1";
+        config.accessKeyId = "AKIDEXAMPLE";
+        config.secretAccessKey = "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY";
+        Aws::S3 s3;
+        s3.Configure(http, config);
+        return s3;
+    }
+
+    /**
+     * Make a successful response with the given body.
+     *
+     * @param[in] body
+     *     This is the body of the response.
+     *
+     * @return
+     *     The response is returned.
+     */
+    Http::Response MakeResponse(const std::string& body) {
+        Http::Response response;
+        response.statusCode = 200;
+        response.reasonPhrase = "OK";
+        response.headers.AddHeader("ETag", "\"2f1020bd8ec6dcc71b2ee36ad3b577c4\"");
+        response.headers.AddHeader("Content-Length", std::to_string(body.length()));
+        response.body = body;
+        response.state = Http::Response::State::Complete;
+        return response;
+    }
+
+    /**
+     * Make the body of a response to a ListBuckets request listing the
+     * given number of buckets.
+     */
+    std::string MakeListBucketsBody(size_t numBuckets) {
+        std::string body = (
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<ListAllMyBucketsResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+            "<Owner><ID>12345</ID><DisplayName>alex</DisplayName></Owner>"
+            "<Buckets>"
+        );
+        for (size_t i = 0; i < numBuckets; ++i) {
+            body += (
+                "<Bucket><Name>bucket" + std::to_string(i) + "</Name>"
+                "<CreationDate>2018-02-01T08:30:12.123Z</CreationDate></Bucket>"
+            );
+        }
+        body += (
+            "</Buckets>"
+            "</ListAllMyBucketsResult>"
+        );
+        return body;
+    }
+
+    /**
+     * Make the body of a response to a ListObjects request listing the
+     * given number of objects in a single page.
+     */
+    std::string MakeListObjectsBody(size_t numObjects) {
+        std::string body = (
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+            "<Name>my_bucket</Name>"
+            "<KeyCount>" + std::to_string(numObjects) + "</KeyCount>"
+            "<MaxKeys>1000</MaxKeys>"
+            "<IsTruncated>false</IsTruncated>"
+        );
+        for (size_t i = 0; i < numObjects; ++i) {
+            body += (
+                "<Contents>"
+                "<Key>photos/2019/03/image" + std::to_string(i) + ".jpg</Key>"
+                "<LastModified>2019-03-03T05:22:16.121Z</LastModified>"
+                "<ETag>&quot;2f1020bd8ec6dcc71b2ee36ad3b577c4&quot;</ETag>"
+                "<Size>156</Size>"
+                "<StorageClass>STANDARD</StorageClass>"
+                "</Contents>"
+            );
+        }
+        body += "</ListBucketResult>";
+        return body;
+    }
+
+    /**
+     * Carry out the given operation once per benchmark iteration, timing
+     * each one and counting the allocations made, and report the
+     * results.
+     *
+     * @param[in,out] state
+     *     This is the state of the benchmark.
+     *
+     * @param[in] operation
+     *     This is the operation to carry out.  It should wait for the
+     *     operation to complete before returning.
+     */
+    void MeasureOperation(
+        benchmark::State& state,
+        const std::function< void() >& operation
+    ) {
+        std::vector< double > latencies;
+        latencies.reserve((size_t)state.max_iterations);
+        const auto allocationsBefore = numAllocations.load();
+        for (auto _: state) {
+            const auto start = std::chrono::steady_clock::now();
+            operation();
+            const auto end = std::chrono::steady_clock::now();
+            latencies.push_back(
+                std::chrono::duration< double, std::micro >(end - start).count()
+            );
+        }
+        const auto allocations = numAllocations.load() - allocationsBefore;
+        if (latencies.empty()) {
+            return;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&latencies](double fraction){
+            return latencies[std::min(
+                (size_t)(fraction * latencies.size()),
+                latencies.size() - 1
+            )];
+        };
+        state.SetItemsProcessed(state.iterations());
+        state.counters["p50_us"] = percentile(0.50);
+        state.counters["p99_us"] = percentile(0.99);
+        state.counters["allocs_per_op"] = benchmark::Counter(
+            (double)allocations,
+            benchmark::Counter::kAvgIterations
+        );
+    }
+
+}
+
+/**
+ * Measure listing buckets, with an increasing number of buckets.
+ */
+static void ListBuckets(benchmark::State& state) {
+    auto s3 = MakeS3(MakeResponse(MakeListBucketsBody((size_t)state.range(0))));
+    MeasureOperation(
+        state,
+        [&s3]{
+            benchmark::DoNotOptimize(s3.ListBuckets().get());
+        }
+    );
+}
+BENCHMARK(ListBuckets)->RangeMultiplier(10)->Range(1, 1000)->UseRealTime();
+
+/**
+ * Measure listing objects, with an increasing number of objects.
+ */
+static void ListObjects(benchmark::State& state) {
+    auto s3 = MakeS3(MakeResponse(MakeListObjectsBody((size_t)state.range(0))));
+    MeasureOperation(
+        state,
+        [&s3]{
+            benchmark::DoNotOptimize(s3.ListObjects("my_bucket").get());
+        }
+    );
+}
+BENCHMARK(ListObjects)->RangeMultiplier(10)->Range(1, 1000)->UseRealTime();
+
+/**
+ * Measure listing objects in compact form, with an increasing number of
+ * objects.
+ */
+static void ListObjectsCompact(benchmark::State& state) {
+    auto s3 = MakeS3(MakeResponse(MakeListObjectsBody((size_t)state.range(0))));
+    MeasureOperation(
+        state,
+        [&s3]{
+            benchmark::DoNotOptimize(s3.ListObjectsCompact("my_bucket").get());
+        }
+    );
+}
+BENCHMARK(ListObjectsCompact)->RangeMultiplier(10)->Range(1, 1000)->UseRealTime();
+
+/**
+ * Measure getting objects, with increasing object sizes.
+ */
+static void GetObject(benchmark::State& state) {
+    auto s3 = MakeS3(MakeResponse(std::string((size_t)state.range(0), 'x')));
+    MeasureOperation(
+        state,
+        [&s3]{
+            benchmark::DoNotOptimize(s3.GetObject("my_bucket", "photos/image.jpg").get());
+        }
+    );
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(GetObject)->Arg(0)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->UseRealTime();
+
+/**
+ * Measure putting objects, with increasing object sizes.  The payload is
+ * signed, so this includes hashing it.
+ */
+static void PutObject(benchmark::State& state) {
+    auto s3 = MakeS3(MakeResponse(""));
+    const std::string contents((size_t)state.range(0), 'x');
+    MeasureOperation(
+        state,
+        [&s3, &contents]{
+            benchmark::DoNotOptimize(s3.PutObject("my_bucket", "photos/image.jpg", contents).get());
+        }
+    );
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PutObject)->Arg(0)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->UseRealTime();
+
+/**
+ * Measure putting objects without signing the payload, with increasing
+ * object sizes.
+ */
+static void PutObjectUnsignedPayload(benchmark::State& state) {
+    auto s3 = MakeS3(MakeResponse(""));
+    const std::string contents((size_t)state.range(0), 'x');
+    MeasureOperation(
+        state,
+        [&s3, &contents]{
+            benchmark::DoNotOptimize(
+                s3.PutObject(
+                    "my_bucket",
+                    "photos/image.jpg",
+                    contents,
+                    {},
+                    Aws::S3::PayloadSigning::Unsigned
+                ).get()
+            );
+        }
+    );
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(PutObjectUnsignedPayload)->Arg(0)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->UseRealTime();
+
+BENCHMARK_MAIN();
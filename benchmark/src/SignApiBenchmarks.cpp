@@ -0,0 +1,505 @@
+/**
+ * @file SignApiBenchmarks.cpp
+ *
+ * This module contains the benchmarks of the
+ * Aws::SignApi class.
+ *
+ * Each stage of signing (constructing the canonical request, making the
+ * string to sign, and making the authorization) is measured on its own,
+ * as is signing a request from start to finish.  Requests are taken both
+ * from the aws-sig-v4-test-suite vectors used by the unit tests, and
+ * made up with varying numbers of headers, query parameters, and
+ * payload sizes.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <Aws/SignApi.hpp>
+#include <Aws/SigningKeyCache.hpp>
+#include <benchmark/benchmark.h>
+#include <Http/Server.hpp>
+#include <memory>
+#include <sstream>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <SystemAbstractions/File.hpp>
+#include <vector>
+
+#define STRINGIFY(s) #s
+#define STRINGIFY_DEFINE_VALUE(s) STRINGIFY(s)
+#define TEST_VECTOR_DIR_STRING STRINGIFY_DEFINE_VALUE(TEST_VECTOR_DIR)
+
+namespace {
+
+    /**
+     * This is the region used in the test vectors.
+     */
+    const std::string REGION = "us-east-1";
+
+    /**
+     * This is the service used in the test vectors.
+     */
+    const std::string SERVICE = "service";
+
+    /**
+     * This is the ID of the access key used in the test vectors.
+     */
+    const std::string ACCESS_KEY_ID = "AKIDEXAMPLE";
+
+    /**
+     * This is the secret of the access key used in the test vectors.
+     */
+    const std::string ACCESS_KEY_SECRET = "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY";
+
+    /**
+     * This holds one request from the test vectors, in both raw and
+     * structured form.
+     */
+    struct TestVector {
+        /**
+         * This is the name of the test vector.
+         */
+        std::string name;
+
+        /**
+         * This is the raw request message.
+         */
+        std::string rawRequest;
+
+        /**
+         * This is the request broken down into its parts.
+         */
+        Http::Request request;
+    };
+
+    std::string GetFileNameOnly(const std::string& filePath) {
+        const auto delimiter = filePath.find_last_of("/\\");
+        return filePath.substr(delimiter + 1);
+    }
+
+    void FindTestVectors(const std::string& path, std::vector< std::string >& testVectors) {
+        std::vector< std::string > entries;
+        SystemAbstractions::File::ListDirectory(path, entries);
+        for (const auto& entry: entries) {
+            // Skip entry if it isn't a directory.
+            SystemAbstractions::File entryFile(entry);
+            if (!entryFile.IsDirectory()) {
+                continue;
+            }
+
+            // If there is a file in the directory with the same name
+            // and ending in ".req", that directory represents a single test.
+            const auto entryName = GetFileNameOnly(entry);
+            SystemAbstractions::File entryTestFile(entry + "/" + entryName + ".req");
+            if (entryTestFile.IsExisting()) {
+                testVectors.push_back(entryTestFile.GetPath());
+                continue;
+            }
+
+            // Otherwise, scan subdirectories for test vectors.
+            FindTestVectors(entry, testVectors);
+        }
+    }
+
+    char MakeHexDigit(unsigned int value) {
+        if (value < 10) {
+            return (char)(value + '0');
+        } else {
+            return (char)(value - 10 + 'A');
+        }
+    }
+
+    std::string PercentEncode(const std::string& input) {
+        std::string output;
+        for (uint8_t c: input) {
+            if ((c >= 0x21) && (c <= 0x7e)) {
+                output.push_back(c);
+            } else {
+                output.push_back('%');
+                output.push_back(MakeHexDigit(c >> 4));
+                output.push_back(MakeHexDigit(c & 0x0F));
+            }
+        }
+        return output;
+    }
+
+    std::string CleanUpRequest(const std::string& input) {
+        std::ostringstream output;
+        std::istringstream lines(input);
+        std::string line;
+        bool first = true;
+        while (std::getline(lines, line)) {
+            if (first) {
+                first = false;
+                const auto delimiter1 = line.find(' ');
+                const auto delimiter2 = line.find_last_of(' ');
+                auto rawUri = line.substr(
+                    delimiter1 + 1,
+                    delimiter2 - delimiter1 - 1
+                );
+                if (rawUri.substr(0, 2) == "//") {
+                    rawUri = "/" + rawUri.substr(2);
+                }
+                output
+                    << line.substr(0, delimiter1 + 1)
+                    << PercentEncode(rawUri)
+                    << line.substr(delimiter2)
+                    << "\r\n";
+            } else {
+                output << line << "\r\n";
+            }
+        }
+        output << "\r\n\r\n";
+        return output.str();
+    }
+
+    /**
+     * Load the requests from the aws-sig-v4-test-suite vectors which can
+     * be parsed into their parts.
+     *
+     * @return
+     *     The requests from the test vectors are returned.
+     */
+    std::vector< TestVector > LoadTestVectors() {
+        std::vector< std::string > testVectorPaths;
+        FindTestVectors(TEST_VECTOR_DIR_STRING, testVectorPaths);
+        std::vector< TestVector > testVectors;
+        Http::Server server;
+        for (const auto& testVectorPath: testVectorPaths) {
+            SystemAbstractions::File testVectorFile(testVectorPath);
+            if (!testVectorFile.OpenReadOnly()) {
+                continue;
+            }
+            SystemAbstractions::File::Buffer contents(testVectorFile.GetSize());
+            if (testVectorFile.Read(contents) != contents.size()) {
+                continue;
+            }
+            TestVector testVector;
+            testVector.name = GetFileNameOnly(testVectorPath);
+            testVector.name.resize(testVector.name.length() - 4);
+            testVector.rawRequest = CleanUpRequest(
+                std::string(contents.begin(), contents.end())
+            );
+            const auto request = server.ParseRequest(testVector.rawRequest);
+            if (request == nullptr) {
+                continue;
+            }
+            testVector.request = *request;
+            testVectors.push_back(std::move(testVector));
+        }
+        return testVectors;
+    }
+
+    /**
+     * Make up a request to sign, in the form S3 requests take.
+     *
+     * @param[in] numHeaders
+     *     This is the number of extra headers to add to the request.
+     *
+     * @param[in] numQueryParameters
+     *     This is the number of query parameters to add to the request.
+     *
+     * @param[in] bodySize
+     *     This is the number of bytes of payload to add to the request.
+     *
+     * @return
+     *     The request is returned.
+     */
+    Http::Request MakeRequest(
+        size_t numHeaders,
+        size_t numQueryParameters,
+        size_t bodySize
+    ) {
+        Http::Request request;
+        request.method = "PUT";
+        request.target.SetHost("s3.us-east-1.amazonaws.com");
+        request.target.SetPort(443);
+        request.target.SetPath({"", "my_bucket", "photos", "2019", "my object.jpg"});
+        if (numQueryParameters > 0) {
+            std::string query;
+            for (size_t i = 0; i < numQueryParameters; ++i) {
+                if (i > 0) {
+                    query += "&";
+                }
+                query += "param" + std::to_string(numQueryParameters - i) + "=value" + std::to_string(i);
+            }
+            request.target.SetQuery(query);
+        }
+        request.headers.AddHeader("Host", "s3.us-east-1.amazonaws.com");
+        request.headers.AddHeader("X-Amz-Date", "20150830T123600Z");
+        for (size_t i = 0; i < numHeaders; ++i) {
+            request.headers.AddHeader(
+                "X-Amz-Meta-Header" + std::to_string(numHeaders - i),
+                "  some   value " + std::to_string(i)
+            );
+        }
+        request.body.assign(bodySize, 'x');
+        request.headers.AddHeader("Content-Length", std::to_string(bodySize));
+        return request;
+    }
+
+    /**
+     * Measure constructing the canonical request for a raw request
+     * message.
+     */
+    void BenchmarkConstructCanonicalRequestFromRawRequest(
+        benchmark::State& state,
+        const TestVector& testVector
+    ) {
+        for (auto _: state) {
+            benchmark::DoNotOptimize(
+                Aws::SignApi::ConstructCanonicalRequest(testVector.rawRequest)
+            );
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /**
+     * Measure constructing the canonical request for a request which has
+     * already been broken down into its parts.
+     */
+    void BenchmarkConstructCanonicalRequest(
+        benchmark::State& state,
+        const TestVector& testVector
+    ) {
+        Aws::SignApi::CanonicalRequest canonicalRequest;
+        for (auto _: state) {
+            Aws::SignApi::ConstructCanonicalRequest(testVector.request, canonicalRequest);
+            benchmark::DoNotOptimize(canonicalRequest.text.data());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /**
+     * Measure signing a request from start to finish.
+     */
+    void BenchmarkSignRequest(
+        benchmark::State& state,
+        const TestVector& testVector
+    ) {
+        Aws::SigningKeyCache signingKeyCache;
+        Aws::SignApi::RequestSignature signature;
+        for (auto _: state) {
+            Aws::SignApi::SignRequest(
+                testVector.request,
+                REGION,
+                SERVICE,
+                ACCESS_KEY_ID,
+                ACCESS_KEY_SECRET,
+                signingKeyCache,
+                signature
+            );
+            benchmark::DoNotOptimize(signature.authorization.data());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /**
+     * Register benchmarks for each request in the test vectors.
+     */
+    void RegisterTestVectorBenchmarks() {
+        static const auto testVectors = LoadTestVectors();
+        for (const auto& testVector: testVectors) {
+            benchmark::RegisterBenchmark(
+                ("ConstructCanonicalRequestFromRawRequest/" + testVector.name).c_str(),
+                BenchmarkConstructCanonicalRequestFromRawRequest,
+                testVector
+            );
+            benchmark::RegisterBenchmark(
+                ("ConstructCanonicalRequest/" + testVector.name).c_str(),
+                BenchmarkConstructCanonicalRequest,
+                testVector
+            );
+            benchmark::RegisterBenchmark(
+                ("SignRequest/" + testVector.name).c_str(),
+                BenchmarkSignRequest,
+                testVector
+            );
+        }
+    }
+
+}
+
+/**
+ * Measure constructing the canonical request for requests with an
+ * increasing number of headers.
+ */
+static void ConstructCanonicalRequestByHeaders(benchmark::State& state) {
+    const auto request = MakeRequest((size_t)state.range(0), 0, 0);
+    Aws::SignApi::CanonicalRequest canonicalRequest;
+    for (auto _: state) {
+        Aws::SignApi::ConstructCanonicalRequest(request, canonicalRequest);
+        benchmark::DoNotOptimize(canonicalRequest.text.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(ConstructCanonicalRequestByHeaders)->RangeMultiplier(4)->Range(1, 256);
+
+/**
+ * Measure constructing the canonical request for requests with an
+ * increasing number of query parameters.
+ */
+static void ConstructCanonicalRequestByQueryParameters(benchmark::State& state) {
+    const auto request = MakeRequest(0, (size_t)state.range(0), 0);
+    Aws::SignApi::CanonicalRequest canonicalRequest;
+    for (auto _: state) {
+        Aws::SignApi::ConstructCanonicalRequest(request, canonicalRequest);
+        benchmark::DoNotOptimize(canonicalRequest.text.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(ConstructCanonicalRequestByQueryParameters)->RangeMultiplier(4)->Range(1, 256);
+
+/**
+ * Measure constructing the canonical request for requests with an
+ * increasing payload size, which is dominated by hashing the payload.
+ */
+static void ConstructCanonicalRequestByBodySize(benchmark::State& state) {
+    const auto request = MakeRequest(0, 0, (size_t)state.range(0));
+    Aws::SignApi::CanonicalRequest canonicalRequest;
+    for (auto _: state) {
+        Aws::SignApi::ConstructCanonicalRequest(request, canonicalRequest);
+        benchmark::DoNotOptimize(canonicalRequest.text.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ConstructCanonicalRequestByBodySize)->Arg(0)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+/**
+ * Measure making the string to sign from a canonical request given as
+ * text, which has to be hashed.
+ */
+static void MakeStringToSignFromText(benchmark::State& state) {
+    const auto request = MakeRequest(4, 4, 0);
+    const auto canonicalRequest = Aws::SignApi::ConstructCanonicalRequest(request);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(
+            Aws::SignApi::MakeStringToSign(REGION, SERVICE, canonicalRequest.text)
+        );
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(MakeStringToSignFromText);
+
+/**
+ * Measure making the string to sign from a structured canonical request.
+ */
+static void MakeStringToSign(benchmark::State& state) {
+    const auto request = MakeRequest(4, 4, 0);
+    const auto canonicalRequest = Aws::SignApi::ConstructCanonicalRequest(request);
+    Aws::SignApi::StringToSign stringToSign;
+    for (auto _: state) {
+        Aws::SignApi::MakeStringToSign(REGION, SERVICE, canonicalRequest, stringToSign);
+        benchmark::DoNotOptimize(stringToSign.text.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(MakeStringToSign);
+
+/**
+ * Measure making the authorization from text, deriving the signing key
+ * every time.
+ */
+static void MakeAuthorizationFromText(benchmark::State& state) {
+    const auto request = MakeRequest(4, 4, 0);
+    const auto canonicalRequest = Aws::SignApi::ConstructCanonicalRequest(request);
+    const auto stringToSign = Aws::SignApi::MakeStringToSign(REGION, SERVICE, canonicalRequest.text);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(
+            Aws::SignApi::MakeAuthorization(
+                stringToSign,
+                canonicalRequest.text,
+                ACCESS_KEY_ID,
+                ACCESS_KEY_SECRET
+            )
+        );
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(MakeAuthorizationFromText);
+
+/**
+ * Measure making the authorization from the structured results of the
+ * earlier stages, taking the signing key from a cache.
+ */
+static void MakeAuthorization(benchmark::State& state) {
+    const auto request = MakeRequest(4, 4, 0);
+    const auto canonicalRequest = Aws::SignApi::ConstructCanonicalRequest(request);
+    Aws::SignApi::StringToSign stringToSign;
+    Aws::SignApi::MakeStringToSign(REGION, SERVICE, canonicalRequest, stringToSign);
+    Aws::SigningKeyCache signingKeyCache;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(
+            Aws::SignApi::MakeAuthorization(
+                canonicalRequest,
+                stringToSign,
+                ACCESS_KEY_ID,
+                ACCESS_KEY_SECRET,
+                signingKeyCache
+            )
+        );
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(MakeAuthorization);
+
+/**
+ * Measure signing requests from start to finish, with increasing numbers
+ * of headers and query parameters.
+ */
+static void SignRequest(benchmark::State& state) {
+    const auto request = MakeRequest((size_t)state.range(0), (size_t)state.range(1), 0);
+    Aws::SigningKeyCache signingKeyCache;
+    Aws::SignApi::RequestSignature signature;
+    for (auto _: state) {
+        Aws::SignApi::SignRequest(
+            request,
+            REGION,
+            SERVICE,
+            ACCESS_KEY_ID,
+            ACCESS_KEY_SECRET,
+            signingKeyCache,
+            signature
+        );
+        benchmark::DoNotOptimize(signature.authorization.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(SignRequest)->Ranges({{1, 64}, {0, 64}});
+
+/**
+ * Measure signing requests from start to finish, with increasing payload
+ * sizes.
+ */
+static void SignRequestByBodySize(benchmark::State& state) {
+    const auto request = MakeRequest(4, 0, (size_t)state.range(0));
+    Aws::SigningKeyCache signingKeyCache;
+    Aws::SignApi::RequestSignature signature;
+    for (auto _: state) {
+        Aws::SignApi::SignRequest(
+            request,
+            REGION,
+            SERVICE,
+            ACCESS_KEY_ID,
+            ACCESS_KEY_SECRET,
+            signingKeyCache,
+            signature
+        );
+        benchmark::DoNotOptimize(signature.authorization.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SignRequestByBodySize)->Arg(0)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    RegisterTestVectorBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+/**
+ * @file CompactObjectList.hpp
+ *
+ * This module declares the Aws::CompactObjectList structure.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <array>
+#include <map>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Aws {
+
+    /**
+     * This structure holds information about a list of objects in an S3
+     * bucket in a compact form, suitable for very large lists.
+     *
+     * Rather than a separate structure for each object, each piece of
+     * information about the objects is stored in its own array (column),
+     * indexed by the position of the object in the list.  The keys are
+     * packed one after another into a single string, and entity tags are
+     * stored as binary digests, so no memory is allocated per object.
+     */
+    struct CompactObjectList {
+        // Types
+
+        /**
+         * This is the type used to hold the binary digest part of an
+         * entity tag.
+         */
+        typedef std::array< uint8_t, 16 > Digest;
+
+        // Properties
+
+        /**
+         * These are the keys of the objects, one after another.
+         */
+        std::string keys;
+
+        /**
+         * This is the offset into keys of the key of each object.
+         */
+        std::vector< size_t > keyOffsets;
+
+        /**
+         * This is the binary form of the 128-bit digest in the entity tag
+         * of each object.  For objects uploaded in one piece, this is
+         * normally the MD5 digest of the object.
+         */
+        std::vector< Digest > eTagDigests;
+
+        /**
+         * For each object which was uploaded in parts, this is the number
+         * of parts, which is appended to the entity tag after a dash.
+         * For other objects, this is zero.
+         */
+        std::vector< uint32_t > eTagPartCounts;
+
+        /**
+         * This is the time, in milliseconds past the UNIX epoch (midnight
+         * UTC, January 1, 1970), when each object was last modified.
+         */
+        std::vector< int64_t > lastModified;
+
+        /**
+         * This is the size of each object in bytes.
+         */
+        std::vector< uint64_t > sizes;
+
+        /**
+         * This holds the entity tags of any objects whose entity tags
+         * don't consist of a 128-bit digest in hexadecimal, optionally
+         * followed by a part count.  It's keyed by the position of the
+         * object in the list.  The digests of these objects are all zero.
+         */
+        std::map< size_t, std::string > irregularETags;
+
+        // Methods
+
+        /**
+         * Return the number of objects in the list.
+         *
+         * @return
+         *     The number of objects in the list is returned.
+         */
+        size_t GetSize() const;
+
+        /**
+         * Return a pointer to the key of the given object.  The key isn't
+         * terminated, and the pointer is only valid until another object
+         * is added to the list.
+         *
+         * @param[in] index
+         *     This is the position of the object in the list.
+         *
+         * @return
+         *     A pointer to the key of the object is returned.
+         */
+        const char* GetKeyData(size_t index) const;
+
+        /**
+         * Return the length of the key of the given object.
+         *
+         * @param[in] index
+         *     This is the position of the object in the list.
+         *
+         * @return
+         *     The number of characters in the key of the object is
+         *     returned.
+         */
+        size_t GetKeyLength(size_t index) const;
+
+        /**
+         * Return a copy of the key of the given object.
+         *
+         * @param[in] index
+         *     This is the position of the object in the list.
+         *
+         * @return
+         *     A copy of the key of the object is returned.
+         */
+        std::string GetKey(size_t index) const;
+
+        /**
+         * Return the entity tag of the given object, in the form used by
+         * S3, but without the quotation marks.
+         *
+         * @param[in] index
+         *     This is the position of the object in the list.
+         *
+         * @return
+         *     The entity tag of the object is returned.
+         */
+        std::string GetETag(size_t index) const;
+
+        /**
+         * Add an object to the end of the list.
+         *
+         * @param[in] key
+         *     This points to the key of the object.
+         *
+         * @param[in] keyLength
+         *     This is the number of characters in the key.
+         *
+         * @param[in] eTag
+         *     This points to the entity tag of the object, which may or
+         *     may not be enclosed in quotation marks.
+         *
+         * @param[in] eTagLength
+         *     This is the number of characters in the entity tag.
+         *
+         * @param[in] lastModifiedMilliseconds
+         *     This is the time, in milliseconds past the UNIX epoch, when
+         *     the object was last modified.
+         *
+         * @param[in] size
+         *     This is the size of the object in bytes.
+         */
+        void Add(
+            const char* key,
+            size_t keyLength,
+            const char* eTag,
+            size_t eTagLength,
+            int64_t lastModifiedMilliseconds,
+            uint64_t size
+        );
+
+        /**
+         * Make room for the given number of objects, with keys of the given
+         * total length, so that adding them doesn't reallocate any of the
+         * columns.
+         *
+         * @param[in] numObjects
+         *     This is the number of objects for which to make room.
+         *
+         * @param[in] totalKeyLength
+         *     This is the total number of characters in the keys of the
+         *     objects for which to make room.
+         */
+        void Reserve(size_t numObjects, size_t totalKeyLength);
+
+        /**
+         * Remove all objects from the list.
+         */
+        void Clear();
+    };
+
+}
@@ -8,12 +8,20 @@
  * © 2019 by Richard Walters
  */
 
+#include "CompactObjectList.hpp"
 #include "Config.hpp"
+#include "TimestampProvider.hpp"
+#include "WorkerPool.hpp"
 
+#include <chrono>
+#include <functional>
 #include <future>
 #include <Http/IClient.hpp>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <MessageHeaders/MessageHeaders.hpp>
+#include <stddef.h>
 #include <string>
 #include <vector>
 
@@ -27,6 +35,100 @@ namespace Aws {
     class S3 {
         // Types
     public:
+        /**
+         * This is the type of function used to supply the contents of an
+         * object a piece at a time.
+         *
+         * @param[out] buffer
+         *     This is where to place the next piece of the contents.
+         *
+         * @param[in] bufferSize
+         *     This is the maximum number of bytes to place in the buffer.
+         *
+         * @return
+         *     The number of bytes placed in the buffer is returned.
+         *     Zero is returned once the end of the contents is reached.
+         */
+        typedef std::function< size_t(char* buffer, size_t bufferSize) > ContentSource;
+
+        /**
+         * This is the type of function used to accept the contents of
+         * an object a piece at a time, as they're retrieved.
+         *
+         * @param[in] data
+         *     This points to the next piece of the contents.
+         *
+         * @param[in] size
+         *     This is the number of bytes in the piece.
+         *
+         * @return
+         *     An indication of whether or not to continue retrieving the
+         *     contents is returned.
+         */
+        typedef std::function< bool(const char* data, size_t size) > ContentSink;
+
+        /**
+         * This is the type of function used to accept the contents of
+         * an object a piece at a time, in any order, as they're retrieved.
+         *
+         * @param[in] offset
+         *     This is the offset of the piece within the contents.
+         *
+         * @param[in] data
+         *     This points to the piece of the contents.
+         *
+         * @param[in] size
+         *     This is the number of bytes in the piece.
+         *
+         * @return
+         *     An indication of whether or not to continue retrieving the
+         *     contents is returned.
+         */
+        typedef std::function< bool(size_t offset, const char* data, size_t size) > ContentWriter;
+
+        /**
+         * These are the different ways the payload of a request which
+         * stores an object may be covered by the request signature.
+         */
+        enum class PayloadSigning {
+            /**
+             * The SHA-256 hash of the whole payload is computed before
+             * the request is signed, and included in the signature.
+             */
+            Signed,
+
+            /**
+             * The payload is not included in the signature, so it
+             * doesn't have to be hashed at all.  This should only be
+             * used over a secure connection.
+             */
+            Unsigned,
+
+            /**
+             * The payload is sent in chunks using the "aws-chunked"
+             * content encoding, and each chunk carries its own signature,
+             * chained from the signature of the request.  Each chunk is
+             * hashed and signed as it's encoded, rather than hashing the
+             * whole payload before the request can be signed.
+             */
+            Streaming,
+        };
+
+        /**
+         * These are the different kinds of requests made of S3, named
+         * after the S3 API operations they carry out.
+         */
+        enum class Operation {
+            ListBuckets,
+            ListObjects,
+            GetObject,
+            PutObject,
+            CreateMultipartUpload,
+            UploadPart,
+            CompleteMultipartUpload,
+            AbortMultipartUpload,
+        };
+
         /**
          * This describes the owner of an S3 bucket.
          */
@@ -116,6 +218,40 @@ namespace Aws {
             Json::Value errorInfo;
         };
 
+        /**
+         * This holds optional parameters for the S3 ListObjects API, which
+         * select which objects in the bucket to list, and how.
+         */
+        struct ListObjectsOptions {
+            /**
+             * If not empty, only objects whose keys begin with this
+             * prefix are listed.
+             */
+            std::string prefix;
+
+            /**
+             * If not empty, objects whose keys contain this delimiter
+             * after the prefix aren't listed individually.  Instead, the
+             * part of each such key up to and including the first
+             * delimiter after the prefix is listed once as a common
+             * prefix.
+             */
+            std::string delimiter;
+
+            /**
+             * If not empty, only objects whose keys come after this key
+             * are listed.
+             */
+            std::string startAfter;
+
+            /**
+             * If not zero, this is the maximum number of objects and
+             * common prefixes to list in each page.  S3 lists at most
+             * 1000 in each page, which is also what it lists by default.
+             */
+            size_t maxKeys = 0;
+        };
+
         /**
          * This holds the information returned by the S3 ListObjects API.
          */
@@ -136,6 +272,48 @@ namespace Aws {
              */
             std::vector< Object > objects;
 
+            /**
+             * If a delimiter was given, these are the common prefixes
+             * of the keys of the objects which weren't listed
+             * individually.
+             */
+            std::vector< std::string > commonPrefixes;
+
+            /**
+             * If the request was not completely successful, this is a copy
+             * of the error information provided in the last response.
+             */
+            Json::Value errorInfo;
+        };
+
+        /**
+         * This holds the information returned by the S3 ListObjects API,
+         * with the information about the objects held in compact form.
+         */
+        struct CompactListObjectsResult {
+            /**
+             * This is where the final state of the transaction for the last
+             * request made to S3.
+             */
+            Http::IClient::Transaction::State transactionState = Http::IClient::Transaction::State::InProgress;
+
+            /**
+             * This is the HTTP status code from the last request made to S3.
+             */
+            unsigned int statusCode = 0;
+
+            /**
+             * This contains information about the objects in the S3 bucket.
+             */
+            CompactObjectList objects;
+
+            /**
+             * If a delimiter was given, these are the common prefixes
+             * of the keys of the objects which weren't listed
+             * individually.
+             */
+            std::vector< std::string > commonPrefixes;
+
             /**
              * If the request was not completely successful, this is a copy
              * of the error information provided in the last response.
@@ -143,6 +321,54 @@ namespace Aws {
             Json::Value errorInfo;
         };
 
+        /**
+         * This holds the information returned by a single request made to
+         * the S3 ListObjects API, which lists one page of the objects in a
+         * bucket.
+         */
+        struct ListObjectsPageResult {
+            /**
+             * This is where the final state of the transaction for the
+             * request made to S3.
+             */
+            Http::IClient::Transaction::State transactionState = Http::IClient::Transaction::State::InProgress;
+
+            /**
+             * This is the HTTP status code from the request made to S3.
+             */
+            unsigned int statusCode = 0;
+
+            /**
+             * This contains information about the objects in the page.
+             */
+            std::vector< Object > objects;
+
+            /**
+             * If a delimiter was given, these are the common prefixes
+             * in the page of the keys of the objects which weren't listed
+             * individually.
+             */
+            std::vector< std::string > commonPrefixes;
+
+            /**
+             * This indicates whether or not there are more pages of
+             * objects to list after this one.
+             */
+            bool isTruncated = false;
+
+            /**
+             * If there are more pages of objects to list, this identifies
+             * the next page.
+             */
+            std::string nextContinuationToken;
+
+            /**
+             * If the request was not successful, this is a copy of the
+             * error information provided in the response.
+             */
+            Json::Value errorInfo;
+        };
+
         /**
          * This holds the information returned by the S3 GetObject API.
          */
@@ -163,6 +389,13 @@ namespace Aws {
              */
             std::string content;
 
+            /**
+             * This is the number of bytes of content retrieved, whether
+             * they were collected in the content string or delivered
+             * elsewhere.
+             */
+            size_t contentSize = 0;
+
             /**
              * This contains a copy of the headers provided from the S3
              * response, which contains metadata and other information
@@ -206,76 +439,1522 @@ namespace Aws {
             Json::Value errorInfo;
         };
 
-        // Lifecycle management
-    public:
-        ~S3() noexcept;
-        S3(const S3&) = delete;
-        S3(S3&&) noexcept;
-        S3& operator=(const S3&) = delete;
-        S3& operator=(S3&&) noexcept;
-
-        // Public methods
-    public:
         /**
-         * This is the default constructor.
+         * This holds the information returned by the S3 CreateMultipartUpload API.
          */
-        S3();
+        struct CreateMultipartUploadResult {
+            /**
+             * This is where the final state of the transaction for the last
+             * request made to S3.
+             */
+            Http::IClient::Transaction::State transactionState = Http::IClient::Transaction::State::InProgress;
+
+            /**
+             * This is the HTTP status code from the last request made to S3.
+             */
+            unsigned int statusCode = 0;
+
+            /**
+             * This contains a copy of the headers provided from the S3
+             * response.
+             */
+            MessageHeaders::MessageHeaders headers;
+
+            /**
+             * This identifies the multipart upload to S3, for use in
+             * storing the parts of the object.
+             */
+            std::string uploadId;
+
+            /**
+             * If the request was not completely successful, this is a copy
+             * of the error information provided in the last response.
+             */
+            Json::Value errorInfo;
+        };
 
         /**
-         * Set up the object to communicate with Amazon S3.
-         *
-         * @param[in] http
-         *     This is the HTTP client to use to communicate with Amazon S3.
-         *
-         * @param[in] config
-         *     This is the Amazon Web Services (AWS) configuration to use.
+         * This holds the information returned by the S3 UploadPart API.
          */
-        void Configure(
-            std::shared_ptr< Http::IClient > http,
-            Config config = Config::GetDefaults()
-        );
+        struct UploadPartResult {
+            /**
+             * This is where the final state of the transaction for the last
+             * request made to S3.
+             */
+            Http::IClient::Transaction::State transactionState = Http::IClient::Transaction::State::InProgress;
+
+            /**
+             * This is the HTTP status code from the last request made to S3.
+             */
+            unsigned int statusCode = 0;
+
+            /**
+             * This contains a copy of the headers provided from the S3
+             * response.
+             */
+            MessageHeaders::MessageHeaders headers;
+
+            /**
+             * This is the entity tag S3 assigned to the part, which is
+             * needed to complete the multipart upload.
+             */
+            std::string eTag;
+
+            /**
+             * If the request was not completely successful, this is a copy
+             * of the error information provided in the last response.
+             */
+            Json::Value errorInfo;
+        };
 
         /**
-         * Retrieve the list of the S3 buckets available to the user.
-         *
-         * @return
-         *     A future is returned which will return the results of the
-         *     S3 request.
+         * This identifies a part of an object stored in parts, for use in
+         * completing the multipart upload.
          */
-        std::future< ListBucketsResult > ListBuckets();
+        struct CompletedPart {
+            /**
+             * This is the number of the part.
+             */
+            unsigned int partNumber = 0;
+
+            /**
+             * This is the entity tag S3 assigned to the part.
+             */
+            std::string eTag;
+        };
 
         /**
-         * Retrieve the list of the objects in the given S3 bucket.
-         *
-         * @param[in] bucketName
-         *     This is the name of the bucket whose objects should be listed.
-         *
-         * @return
-         *     A future is returned which will return the results of the
-         *     S3 request.
+         * This holds the information returned by the S3 CompleteMultipartUpload API.
          */
-        std::future< ListObjectsResult > ListObjects(const std::string& bucketName);
+        struct CompleteMultipartUploadResult {
+            /**
+             * This is where the final state of the transaction for the last
+             * request made to S3.
+             */
+            Http::IClient::Transaction::State transactionState = Http::IClient::Transaction::State::InProgress;
+
+            /**
+             * This is the HTTP status code from the last request made to S3.
+             */
+            unsigned int statusCode = 0;
+
+            /**
+             * This contains a copy of the headers provided from the S3
+             * response.
+             */
+            MessageHeaders::MessageHeaders headers;
+
+            /**
+             * This is the entity tag S3 assigned to the object.
+             */
+            std::string eTag;
+
+            /**
+             * If the request was not completely successful, this is a copy
+             * of the error information provided in the last response.
+             */
+            Json::Value errorInfo;
+        };
 
         /**
-         * Retrieve the contents of an object in the given S3 bucket.
-         *
-         * @param[in] bucketName
-         *     This is the name of the bucket containing the object.
-         *
-         * @param[in] objectName
-         *     This is the name of the object to retrieve.
-         *
-         * @return
-         *     A future is returned which will return the results of the
-         *     S3 request.
+         * This holds the information returned by the S3 AbortMultipartUpload API.
          */
-        std::future< GetObjectResult > GetObject(
-            const std::string& bucketName,
-            const std::string& objectName
-        );
+        struct AbortMultipartUploadResult {
+            /**
+             * This is where the final state of the transaction for the last
+             * request made to S3.
+             */
+            Http::IClient::Transaction::State transactionState = Http::IClient::Transaction::State::InProgress;
+
+            /**
+             * This is the HTTP status code from the last request made to S3.
+             */
+            unsigned int statusCode = 0;
+
+            /**
+             * If the request was not completely successful, this is a copy
+             * of the error information provided in the last response.
+             */
+            Json::Value errorInfo;
+        };
+
+        /**
+         * This holds a breakdown of where the time went in making a single
+         * request of S3.
+         */
+        struct RequestTimings {
+            /**
+             * This is how long the work which made the request waited in
+             * the worker pool before it started.
+             */
+            std::chrono::nanoseconds queueWait = std::chrono::nanoseconds::zero();
+
+            /**
+             * This is how long it took to construct the canonical form of
+             * the request, including hashing the payload, if it's signed.
+             */
+            std::chrono::nanoseconds canonicalization = std::chrono::nanoseconds::zero();
+
+            /**
+             * This is how long it took to sign the canonical request and
+             * add the authorization to the request.
+             */
+            std::chrono::nanoseconds signing = std::chrono::nanoseconds::zero();
+
+            /**
+             * This is how long the HTTP transaction took, from handing the
+             * request to the HTTP client until the whole response was
+             * received.
+             */
+            std::chrono::nanoseconds transaction = std::chrono::nanoseconds::zero();
+
+            /**
+             * This is how long it took to parse the body of the response.
+             */
+            std::chrono::nanoseconds parsing = std::chrono::nanoseconds::zero();
+        };
+
+        /**
+         * This holds information about a single request made of S3, once
+         * it's complete.
+         */
+        struct RequestMetrics {
+            /**
+             * This is the kind of request made.
+             */
+            Operation operation = Operation::ListBuckets;
+
+            /**
+             * This is the name of the bucket to which the request was
+             * made, or an empty string for requests not made of any
+             * particular bucket, such as ListBuckets.
+             */
+            std::string bucketName;
+
+            /**
+             * This is the HTTP method of the request.
+             */
+            std::string method;
+
+            /**
+             * This is the final state of the transaction for the request.
+             */
+            Http::IClient::Transaction::State transactionState = Http::IClient::Transaction::State::InProgress;
+
+            /**
+             * This is the HTTP status code from the response.
+             */
+            unsigned int statusCode = 0;
+
+            /**
+             * This is the number of bytes in the body of the request.
+             */
+            size_t bytesSent = 0;
+
+            /**
+             * This is the number of bytes in the body of the response.
+             */
+            size_t bytesReceived = 0;
+
+            /**
+             * This is the number of earlier attempts made to carry out
+             * the same request which failed before this one was made.
+             */
+            size_t retries = 0;
+
+            /**
+             * This is how long the request took altogether, from when the
+             * work which made it was queued in the worker pool until the
+             * response was handled.
+             */
+            std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+
+            /**
+             * This is a breakdown of where the time went in making the
+             * request.
+             */
+            RequestTimings timings;
+        };
+
+        /**
+         * This is the type of function called with the results of a
+         * ListBuckets call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(ListBucketsResult result) > ListBucketsDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * ListObjects call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(ListObjectsResult result) > ListObjectsDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * ListObjectsCompact call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 requests.
+         */
+        typedef std::function< void(CompactListObjectsResult result) > CompactListObjectsDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * ListObjectsPage call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(ListObjectsPageResult result) > ListObjectsPageDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * GetObject call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(GetObjectResult result) > GetObjectDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * PutObject call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(PutObjectResult result) > PutObjectDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * CreateMultipartUpload call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(CreateMultipartUploadResult result) > CreateMultipartUploadDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * UploadPart call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(UploadPartResult result) > UploadPartDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * CompleteMultipartUpload call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(CompleteMultipartUploadResult result) > CompleteMultipartUploadDelegate;
+
+        /**
+         * This is the type of function called with the results of a
+         * AbortMultipartUpload call, once they're available.
+         *
+         * @param[in] result
+         *     These are the results of the S3 request.
+         */
+        typedef std::function< void(AbortMultipartUploadResult result) > AbortMultipartUploadDelegate;
+
+        /**
+         * This is the interface to an object which S3 notifies about each
+         * request made of S3, once it's complete.
+         */
+        class MetricsObserver {
+        public:
+            virtual ~MetricsObserver() noexcept = default;
+
+            /**
+             * This is called for each request made of S3, once it's
+             * complete.  It's called from the thread which completes the
+             * HTTP transaction, after the results of the request have been
+             * delivered, so it shouldn't block, and it may be called from
+             * several threads at once.
+             *
+             * @param[in] metrics
+             *     This is information about the request.
+             */
+            virtual void RequestCompleted(const RequestMetrics& metrics) = 0;
+        };
+
+        /**
+         * This class lists the objects in an S3 bucket a page at a time,
+         * so that objects can be processed as soon as each page arrives,
+         * rather than after the whole bucket has been listed.  It can be
+         * used in a range-based for loop, which visits each page in turn:
+         *
+         *     for (const auto& page: s3.ListObjectsInPages("my_bucket")) {
+         *         ...
+         *     }
+         *
+         * If the request for a page fails, that page is the last one
+         * visited, and its results describe the failure.
+         *
+         * Instances may only be used by one thread at a time.
+         */
+        class ObjectPages {
+            // Types
+        public:
+            /**
+             * This is the type of iterator used to visit the pages in turn.
+             * Advancing it waits for the next page to arrive.
+             */
+            class iterator {
+                // Types
+            public:
+                typedef std::input_iterator_tag iterator_category;
+                typedef ListObjectsPageResult value_type;
+                typedef ptrdiff_t difference_type;
+                typedef const ListObjectsPageResult* pointer;
+                typedef const ListObjectsPageResult& reference;
+
+                // Public methods
+            public:
+                /**
+                 * This constructor sets up the iterator to refer to the
+                 * current page of the given pages, or to the end of the
+                 * pages if none are given.
+                 *
+                 * @param[in] pages
+                 *     These are the pages to visit, if any.
+                 */
+                explicit iterator(ObjectPages* pages = nullptr);
+
+                /**
+                 * Return the current page.
+                 *
+                 * @return
+                 *     The current page is returned.
+                 */
+                reference operator*() const;
+
+                /**
+                 * Return a pointer to the current page.
+                 *
+                 * @return
+                 *     A pointer to the current page is returned.
+                 */
+                pointer operator->() const;
+
+                /**
+                 * Wait for the next page and move to it, or to the end of
+                 * the pages if there are no more.
+                 *
+                 * @return
+                 *     A reference to the iterator is returned.
+                 */
+                iterator& operator++();
+
+                /**
+                 * Determine whether or not this iterator refers to the same
+                 * position as the given iterator.
+                 *
+                 * @param[in] other
+                 *     This is the iterator with which to compare.
+                 *
+                 * @return
+                 *     An indication of whether or not the iterators refer
+                 *     to the same position is returned.
+                 */
+                bool operator==(const iterator& other) const;
+
+                /**
+                 * Determine whether or not this iterator refers to a
+                 * different position than the given iterator.
+                 *
+                 * @param[in] other
+                 *     This is the iterator with which to compare.
+                 *
+                 * @return
+                 *     An indication of whether or not the iterators refer
+                 *     to different positions is returned.
+                 */
+                bool operator!=(const iterator& other) const;
+
+                // Private properties
+            private:
+                /**
+                 * These are the pages being visited, or null if the end of
+                 * the pages has been reached.
+                 */
+                ObjectPages* pages_;
+            };
+
+            // Lifecycle management
+        public:
+            ~ObjectPages() noexcept;
+            ObjectPages(const ObjectPages&) = delete;
+            ObjectPages(ObjectPages&&) noexcept;
+            ObjectPages& operator=(const ObjectPages&) = delete;
+            ObjectPages& operator=(ObjectPages&&) noexcept;
+
+            // Public methods
+        public:
+            /**
+             * Wait for the next page of objects to arrive, and return it.
+             * If prefetching is enabled, the request for the page after
+             * it is made before this method returns.
+             *
+             * @param[out] page
+             *     This is where to store the next page.
+             *
+             * @return
+             *     An indication of whether or not there was another page
+             *     to return is returned.
+             */
+            bool GetNextPage(ListObjectsPageResult& page);
+
+            /**
+             * Wait for the first page of objects to arrive, and return
+             * an iterator referring to it.
+             *
+             * @return
+             *     An iterator referring to the first page is returned, or
+             *     the end iterator if there are no pages left to visit.
+             */
+            iterator begin();
+
+            /**
+             * Return the iterator which marks the end of the pages.
+             *
+             * @return
+             *     The iterator which marks the end of the pages is returned.
+             */
+            iterator end();
+
+            // Private methods
+        private:
+            friend class S3;
+
+            /**
+             * This is the type of structure that contains the private
+             * properties of the instance.  It is defined in the
+             * implementation and declared here to ensure that it is scoped
+             * inside the class.
+             */
+            struct Impl;
+
+            /**
+             * This constructor is used by S3 to set up the object.
+             *
+             * @param[in] impl
+             *     These are the private properties of the instance.
+             */
+            explicit ObjectPages(std::unique_ptr< Impl >&& impl);
+
+            // Private properties
+        private:
+            /**
+             * This contains the private properties of the instance.
+             */
+            std::unique_ptr< Impl > impl_;
+        };
+
+        // Lifecycle management
+    public:
+        ~S3() noexcept;
+        S3(const S3&) = delete;
+        S3(S3&&) noexcept;
+        S3& operator=(const S3&) = delete;
+        S3& operator=(S3&&) noexcept;
+
+        // Public methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        S3();
+
+        /**
+         * Set up the object to communicate with Amazon S3.
+         *
+         * @param[in] http
+         *     This is the HTTP client to use to communicate with Amazon S3.
+         *
+         * @param[in] config
+         *     This is the Amazon Web Services (AWS) configuration to use.
+         *
+         * @param[in] workerPool
+         *     This is the worker pool to use to carry out requests.  It
+         *     bounds the number of threads used, no matter how many
+         *     requests are made, and may be shared with other objects.
+         *     If none is given, the object starts its own pool.
+         *
+         * @param[in] timestampProvider
+         *     This provides the current time, formatted for the
+         *     "x-amz-date" header of each request.  It may be shared with
+         *     other objects, and may be given a clock other than the
+         *     system clock (for example, in tests).  If none is given, the
+         *     object makes its own, using the system clock.
+         */
+        void Configure(
+            std::shared_ptr< Http::IClient > http,
+            Config config = Config::GetDefaults(),
+            std::shared_ptr< WorkerPool > workerPool = nullptr,
+            std::shared_ptr< TimestampProvider > timestampProvider = nullptr
+        );
+
+        /**
+         * Set up the object to report information about each request made
+         * of S3, such as how long it took and where the time went, once
+         * the request is complete.  This should be called (like Configure)
+         * before any requests are made.
+         *
+         * @param[in] metricsObserver
+         *     This is the object to notify about each request.  If it's
+         *     null, no information is reported.
+         */
+        void SetMetricsObserver(std::shared_ptr< MetricsObserver > metricsObserver);
+
+        /**
+         * Return the name of the given kind of request, which is the name
+         * of the S3 API operation it carries out.
+         *
+         * @param[in] operation
+         *     This is the kind of request.
+         *
+         * @return
+         *     The name of the given kind of request is returned.
+         */
+        static const char* GetOperationName(Operation operation);
+
+        /**
+         * Retrieve the list of the S3 buckets available to the user.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< ListBucketsResult > ListBuckets();
+
+        /**
+         * Retrieve the list of the S3 buckets available to the user,
+         * without waiting for the S3 request to complete.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void ListBuckets(ListBucketsDelegate onCompletion);
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< ListObjectsResult > ListObjects(const std::string& bucketName);
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket,
+         * selecting which objects to list.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< ListObjectsResult > ListObjects(
+            const std::string& bucketName,
+            const ListObjectsOptions& options
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket,
+         * without waiting for the S3 requests to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void ListObjects(
+            const std::string& bucketName,
+            ListObjectsDelegate onCompletion
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket,
+         * selecting which objects to list, without waiting for the S3
+         * requests to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void ListObjects(
+            const std::string& bucketName,
+            const ListObjectsOptions& options,
+            ListObjectsDelegate onCompletion
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket, holding
+         * the information about the objects in compact form.  This uses
+         * much less memory than ListObjects for very large buckets.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< CompactListObjectsResult > ListObjectsCompact(const std::string& bucketName);
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket,
+         * selecting which objects to list, and holding the information
+         * about the objects in compact form.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< CompactListObjectsResult > ListObjectsCompact(
+            const std::string& bucketName,
+            const ListObjectsOptions& options
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket, holding
+         * the information about the objects in compact form, without
+         * waiting for the S3 requests to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void ListObjectsCompact(
+            const std::string& bucketName,
+            CompactListObjectsDelegate onCompletion
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket,
+         * selecting which objects to list, and holding the information
+         * about the objects in compact form, without waiting for the S3
+         * requests to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void ListObjectsCompact(
+            const std::string& bucketName,
+            const ListObjectsOptions& options,
+            CompactListObjectsDelegate onCompletion
+        );
+
+        /**
+         * Retrieve one page of the list of the objects in the given S3
+         * bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page to retrieve, as given by the
+         *     previous page.  If empty, the first page is retrieved.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< ListObjectsPageResult > ListObjectsPage(
+            const std::string& bucketName,
+            const std::string& continuationToken = ""
+        );
+
+        /**
+         * Retrieve one page of the list of the objects in the given S3
+         * bucket, selecting which objects to list.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page to retrieve, as given by the
+         *     previous page.  If empty, the first page is retrieved.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< ListObjectsPageResult > ListObjectsPage(
+            const std::string& bucketName,
+            const std::string& continuationToken,
+            const ListObjectsOptions& options
+        );
+
+        /**
+         * Retrieve one page of the list of the objects in the given S3
+         * bucket, without waiting for the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page to retrieve, as given by the
+         *     previous page.  If empty, the first page is retrieved.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void ListObjectsPage(
+            const std::string& bucketName,
+            const std::string& continuationToken,
+            ListObjectsPageDelegate onCompletion
+        );
+
+        /**
+         * Retrieve one page of the list of the objects in the given S3
+         * bucket, selecting which objects to list, without waiting for
+         * the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page to retrieve, as given by the
+         *     previous page.  If empty, the first page is retrieved.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void ListObjectsPage(
+            const std::string& bucketName,
+            const std::string& continuationToken,
+            const ListObjectsOptions& options,
+            ListObjectsPageDelegate onCompletion
+        );
+
+        /**
+         * Return an object which lists the objects in the given S3 bucket
+         * a page at a time.  No requests are made until the first page
+         * is asked for.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] prefetch
+         *     This indicates whether or not to request each page as soon
+         *     as the one before it arrives, so that it's retrieved while
+         *     the caller processes the page before it.
+         *
+         * @return
+         *     An object which lists the objects a page at a time is
+         *     returned.
+         */
+        ObjectPages ListObjectsInPages(
+            const std::string& bucketName,
+            bool prefetch = true
+        );
+
+        /**
+         * Return an object which lists the objects in the given S3 bucket
+         * a page at a time, selecting which objects to list.  No requests are made until the first page
+         * is asked for.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] prefetch
+         *     This indicates whether or not to request each page as soon
+         *     as the one before it arrives, so that it's retrieved while
+         *     the caller processes the page before it.
+         *
+         * @return
+         *     An object which lists the objects a page at a time is
+         *     returned.
+         */
+        ObjectPages ListObjectsInPages(
+            const std::string& bucketName,
+            const ListObjectsOptions& options,
+            bool prefetch = true
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket, dividing
+         * the keys into partitions which are listed at the same time.  The
+         * results of the partitions are merged, so the objects are listed
+         * in order, as they would be by ListObjects.
+         *
+         * Each split point is the last key which can be in the partition
+         * before it, and the partition after it lists the keys which come
+         * after it.  For example, the common prefixes found by listing the
+         * bucket with a delimiter make good split points.
+         *
+         * The results are those of the last request made, unless any
+         * request fails, in which case they are those of the first
+         * partition which failed.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] splitPoints
+         *     These are the keys which divide the partitions.
+         *
+         * @param[in] maxPartitionsInFlight
+         *     This is the maximum number of partitions to list at once.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< ListObjectsResult > ListObjectsInParallel(
+            const std::string& bucketName,
+            const std::vector< std::string >& splitPoints,
+            size_t maxPartitionsInFlight = 8
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket, dividing
+         * the keys into partitions which are listed at the same time.  The
+         * results of the partitions are merged, so the objects are listed
+         * in order, as they would be by ListObjects.
+         *
+         * Each split point is the last key which can be in the partition
+         * before it, and the partition after it lists the keys which come
+         * after it.  For example, the common prefixes found by listing the
+         * bucket with a delimiter make good split points.
+         *
+         * The results are those of the last request made, unless any
+         * request fails, in which case they are those of the first
+         * partition which failed.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] splitPoints
+         *     These are the keys which divide the partitions.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] maxPartitionsInFlight
+         *     This is the maximum number of partitions to list at once.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< ListObjectsResult > ListObjectsInParallel(
+            const std::string& bucketName,
+            const std::vector< std::string >& splitPoints,
+            const ListObjectsOptions& options,
+            size_t maxPartitionsInFlight = 8
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket, dividing
+         * the keys into partitions which are listed at the same time,
+         * without waiting for the S3 requests to complete.  The
+         * results of the partitions are merged, so the objects are listed
+         * in order, as they would be by ListObjects.
+         *
+         * Each split point is the last key which can be in the partition
+         * before it, and the partition after it lists the keys which come
+         * after it.  For example, the common prefixes found by listing the
+         * bucket with a delimiter make good split points.
+         *
+         * The results are those of the last request made, unless any
+         * request fails, in which case they are those of the first
+         * partition which failed.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] splitPoints
+         *     These are the keys which divide the partitions.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from a worker thread, so it
+         *     shouldn't block.
+         *
+         * @param[in] maxPartitionsInFlight
+         *     This is the maximum number of partitions to list at once.
+         */
+        void ListObjectsInParallel(
+            const std::string& bucketName,
+            const std::vector< std::string >& splitPoints,
+            ListObjectsDelegate onCompletion,
+            size_t maxPartitionsInFlight = 8
+        );
+
+        /**
+         * Retrieve the list of the objects in the given S3 bucket, dividing
+         * the keys into partitions which are listed at the same time,
+         * without waiting for the S3 requests to complete.  The
+         * results of the partitions are merged, so the objects are listed
+         * in order, as they would be by ListObjects.
+         *
+         * Each split point is the last key which can be in the partition
+         * before it, and the partition after it lists the keys which come
+         * after it.  For example, the common prefixes found by listing the
+         * bucket with a delimiter make good split points.
+         *
+         * The results are those of the last request made, unless any
+         * request fails, in which case they are those of the first
+         * partition which failed.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket whose objects should be listed.
+         *
+         * @param[in] splitPoints
+         *     These are the keys which divide the partitions.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from a worker thread, so it
+         *     shouldn't block.
+         *
+         * @param[in] maxPartitionsInFlight
+         *     This is the maximum number of partitions to list at once.
+         */
+        void ListObjectsInParallel(
+            const std::string& bucketName,
+            const std::vector< std::string >& splitPoints,
+            const ListObjectsOptions& options,
+            ListObjectsDelegate onCompletion,
+            size_t maxPartitionsInFlight = 8
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< GetObjectResult > GetObject(
+            const std::string& bucketName,
+            const std::string& objectName
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket,
+         * without waiting for the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void GetObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            GetObjectDelegate onCompletion
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket,
+         * handing them to the given sink a piece at a time rather than
+         * collecting them in the results.  The object is requested one
+         * range of bytes at a time, so no more than one range is held
+         * in memory at once, however big the object is.
+         *
+         * Once the whole object is retrieved, the status code in the
+         * results is 200 (OK), even though each range is provided in a
+         * 206 (Partial Content) response.  The headers in the results
+         * are those of the first response.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] contentSink
+         *     This is the function to call with each piece of the object
+         *     contents, in order.  It's called from a thread other than
+         *     the caller's.  If it returns false, retrieval stops, and
+         *     the transaction state in the results is Broken.
+         *
+         * @param[in] chunkSize
+         *     This is the number of bytes to request at a time.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< GetObjectResult > GetObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            ContentSink contentSink,
+            size_t chunkSize = 8388608
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket,
+         * handing them to the given sink a piece at a time, without
+         * waiting for the S3 requests to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] contentSink
+         *     This is the function to call with each piece of the object
+         *     contents, in order.  It's called from a thread other than
+         *     the caller's.  If it returns false, retrieval stops, and
+         *     the transaction state in the results is Broken.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     last HTTP transaction, so it shouldn't block.
+         *
+         * @param[in] chunkSize
+         *     This is the number of bytes to request at a time.
+         */
+        void GetObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            ContentSink contentSink,
+            GetObjectDelegate onCompletion,
+            size_t chunkSize = 8388608
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket,
+         * placing them directly in the given buffer rather than
+         * collecting them in the results.  The buffer may be any
+         * contiguous memory owned by the caller, such as a memory-mapped
+         * file already sized to fit the object.
+         *
+         * If the object is larger than the buffer, retrieval stops once
+         * the buffer is full, and the transaction state in the results
+         * is Broken.  Otherwise, the content size in the results is the
+         * number of bytes placed in the buffer.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[out] buffer
+         *     This is where to place the object contents.  It must
+         *     remain valid until the S3 requests are complete.
+         *
+         * @param[in] bufferSize
+         *     This is the size of the buffer, in bytes.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< GetObjectResult > GetObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            char* buffer,
+            size_t bufferSize
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket,
+         * placing them directly in the given buffer, without waiting for
+         * the S3 requests to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[out] buffer
+         *     This is where to place the object contents.  It must
+         *     remain valid until the S3 requests are complete.
+         *
+         * @param[in] bufferSize
+         *     This is the size of the buffer, in bytes.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     last HTTP transaction, so it shouldn't block.
+         */
+        void GetObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            char* buffer,
+            size_t bufferSize,
+            GetObjectDelegate onCompletion
+        );
+
+        /**
+         * Retrieve a range of bytes of an object in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] offset
+         *     This is the offset of the first byte to retrieve.
+         *
+         * @param[in] length
+         *     This is the number of bytes to retrieve.  Fewer are
+         *     retrieved if the object ends sooner.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.  If successful, the status code is 206 (Partial
+         *     Content), and the "Content-Range" header in the results
+         *     indicates which bytes were retrieved.
+         */
+        std::future< GetObjectResult > GetObjectRange(
+            const std::string& bucketName,
+            const std::string& objectName,
+            size_t offset,
+            size_t length
+        );
+
+        /**
+         * Retrieve a range of bytes of an object in the given S3 bucket,
+         * without waiting for the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] offset
+         *     This is the offset of the first byte to retrieve.
+         *
+         * @param[in] length
+         *     This is the number of bytes to retrieve.  Fewer are
+         *     retrieved if the object ends sooner.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void GetObjectRange(
+            const std::string& bucketName,
+            const std::string& objectName,
+            size_t offset,
+            size_t length,
+            GetObjectDelegate onCompletion
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket by
+         * splitting it into parts and requesting several parts at once,
+         * handing each part to the given writer as it arrives.
+         *
+         * The first part is requested on its own to learn the size of the
+         * object.  After that, up to the given number of parts are kept
+         * in flight at once over the HTTP client.  All parts after the
+         * first must match the entity tag of the first.
+         *
+         * Once the whole object is retrieved, the status code in the
+         * results is 200 (OK), and the content size is the size of the
+         * object.  The headers in the results are those of the response
+         * for the first part.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] contentWriter
+         *     This is the function to call with each part of the object.
+         *     It's called from threads other than the caller's, and may
+         *     be called for different parts at the same time.  If it
+         *     returns false, no more parts are requested, and the
+         *     transaction state in the results is Broken.
+         *
+         * @param[in] partSize
+         *     This is the number of bytes to request in each part.
+         *
+         * @param[in] maxPartsInFlight
+         *     This is the maximum number of parts to request at once.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< GetObjectResult > DownloadObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            ContentWriter contentWriter,
+            size_t partSize = 8388608,
+            size_t maxPartsInFlight = 8
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket by
+         * splitting it into parts and requesting several parts at once,
+         * without waiting for the S3 requests to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] contentWriter
+         *     This is the function to call with each part of the object.
+         *     It's called from threads other than the caller's, and may
+         *     be called for different parts at the same time.  If it
+         *     returns false, no more parts are requested, and the
+         *     transaction state in the results is Broken.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     last HTTP transaction, so it shouldn't block.
+         *
+         * @param[in] partSize
+         *     This is the number of bytes to request in each part.
+         *
+         * @param[in] maxPartsInFlight
+         *     This is the maximum number of parts to request at once.
+         */
+        void DownloadObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            ContentWriter contentWriter,
+            GetObjectDelegate onCompletion,
+            size_t partSize = 8388608,
+            size_t maxPartsInFlight = 8
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket by
+         * splitting it into parts and requesting several parts at once,
+         * placing each part directly in the given buffer.
+         *
+         * If the object is larger than the buffer, retrieval stops, and
+         * the transaction state in the results is Broken.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[out] buffer
+         *     This is where to place the object contents.  It must
+         *     remain valid until the S3 requests are complete.
+         *
+         * @param[in] bufferSize
+         *     This is the size of the buffer, in bytes.
+         *
+         * @param[in] partSize
+         *     This is the number of bytes to request in each part.
+         *
+         * @param[in] maxPartsInFlight
+         *     This is the maximum number of parts to request at once.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< GetObjectResult > DownloadObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            char* buffer,
+            size_t bufferSize,
+            size_t partSize = 8388608,
+            size_t maxPartsInFlight = 8
+        );
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket by
+         * splitting it into parts and requesting several parts at once,
+         * placing each part directly in the given buffer, without waiting
+         * for the S3 requests to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[out] buffer
+         *     This is where to place the object contents.  It must
+         *     remain valid until the S3 requests are complete.
+         *
+         * @param[in] bufferSize
+         *     This is the size of the buffer, in bytes.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     last HTTP transaction, so it shouldn't block.
+         *
+         * @param[in] partSize
+         *     This is the number of bytes to request in each part.
+         *
+         * @param[in] maxPartsInFlight
+         *     This is the maximum number of parts to request at once.
+         */
+        void DownloadObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            char* buffer,
+            size_t bufferSize,
+            GetObjectDelegate onCompletion,
+            size_t partSize = 8388608,
+            size_t maxPartsInFlight = 8
+        );
+
+        /**
+         * Store the given contents as an object in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] contents
+         *     This is the contents to store in the object.
+         *
+         * @param[in] extraHeaders
+         *     This is an optional dictionary listing extra headers to
+         *     include in the API call.
+         *
+         * @param[in] payloadSigning
+         *     This indicates how the contents should be covered by the
+         *     request signature.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< PutObjectResult > PutObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& contents,
+            const std::map< std::string, std::string > extraHeaders = {},
+            PayloadSigning payloadSigning = PayloadSigning::Signed
+        );
 
         /**
-         * Store the given contents as an object in the given S3 bucket.
+         * Store the given contents as an object in the given S3 bucket,
+         * without waiting for the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] contents
+         *     This is the contents to store in the object.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         *
+         * @param[in] extraHeaders
+         *     This is an optional dictionary listing extra headers to
+         *     include in the API call.
+         *
+         * @param[in] payloadSigning
+         *     This indicates how the contents should be covered by the
+         *     request signature.
+         */
+        void PutObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& contents,
+            PutObjectDelegate onCompletion,
+            const std::map< std::string, std::string > extraHeaders = {},
+            PayloadSigning payloadSigning = PayloadSigning::Signed
+        );
+
+        /**
+         * Store the given contents as an object in the given S3 bucket,
+         * without waiting for the S3 request to complete.  The contents
+         * are moved into the request rather than copied.
          *
          * @param[in] bucketName
          *     This is the name of the bucket in which to store the object.
@@ -286,10 +1965,61 @@ namespace Aws {
          * @param[in] contents
          *     This is the contents to store in the object.
          *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         *
+         * @param[in] extraHeaders
+         *     This is an optional dictionary listing extra headers to
+         *     include in the API call.
+         *
+         * @param[in] payloadSigning
+         *     This indicates how the contents should be covered by the
+         *     request signature.
+         */
+        void PutObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            std::string&& contents,
+            PutObjectDelegate onCompletion,
+            const std::map< std::string, std::string > extraHeaders = {},
+            PayloadSigning payloadSigning = PayloadSigning::Signed
+        );
+
+        /**
+         * Store contents supplied a piece at a time as an object in the
+         * given S3 bucket.  The contents are hashed as they're read, so
+         * the payload hash used to sign the request is ready as soon as the
+         * last piece is read, and the contents are never copied just to be
+         * hashed.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] contentSource
+         *     This is the function to call to read the contents to store
+         *     in the object.  It's called repeatedly, from a thread
+         *     other than the caller's, until it returns zero.
+         *
          * @param[in] extraHeaders
          *     This is an optional dictionary listing extra headers to
          *     include in the API call.
          *
+         * @param[in] contentLength
+         *     If known, this is the size of the contents, in bytes.  It's
+         *     used to avoid growing memory more than once while reading
+         *     the contents.  When the payload is streamed, it also allows
+         *     each chunk to be signed as soon as it's read; otherwise all
+         *     the contents are read before the first chunk is signed.
+         *
+         * @param[in] payloadSigning
+         *     This indicates how the contents should be covered by the
+         *     request signature.
+         *
          * @return
          *     A future is returned which will return the results of the
          *     S3 request.
@@ -297,10 +2027,407 @@ namespace Aws {
         std::future< PutObjectResult > PutObject(
             const std::string& bucketName,
             const std::string& objectName,
-            const std::string& contents,
+            ContentSource contentSource,
+            const std::map< std::string, std::string > extraHeaders = {},
+            size_t contentLength = 0,
+            PayloadSigning payloadSigning = PayloadSigning::Signed
+        );
+
+        /**
+         * Store contents supplied a piece at a time as an object in the
+         * given S3 bucket, without waiting for the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] contentSource
+         *     This is the function to call to read the contents to store
+         *     in the object.  It's called repeatedly, from a thread
+         *     other than the caller's, until it returns zero.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         *
+         * @param[in] extraHeaders
+         *     This is an optional dictionary listing extra headers to
+         *     include in the API call.
+         *
+         * @param[in] contentLength
+         *     If known, this is the size of the contents, in bytes.
+         *
+         * @param[in] payloadSigning
+         *     This indicates how the contents should be covered by the
+         *     request signature.
+         */
+        void PutObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            ContentSource contentSource,
+            PutObjectDelegate onCompletion,
+            const std::map< std::string, std::string > extraHeaders = {},
+            size_t contentLength = 0,
+            PayloadSigning payloadSigning = PayloadSigning::Signed
+        );
+
+        /**
+         * Begin storing an object in the given S3 bucket in parts.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] extraHeaders
+         *     This is an optional dictionary listing extra headers to
+         *     include in the API call, such as those setting the content
+         *     type or metadata of the object.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< CreateMultipartUploadResult > CreateMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::map< std::string, std::string > extraHeaders = {}
+        );
+
+        /**
+         * Begin storing an object in the given S3 bucket in parts,
+         * without waiting for the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         *
+         * @param[in] extraHeaders
+         *     This is an optional dictionary listing extra headers to
+         *     include in the API call, such as those setting the content
+         *     type or metadata of the object.
+         */
+        void CreateMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            CreateMultipartUploadDelegate onCompletion,
             const std::map< std::string, std::string > extraHeaders = {}
         );
 
+        /**
+         * Store one part of an object being stored in parts.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3, as returned
+         *     by CreateMultipartUpload.
+         *
+         * @param[in] partNumber
+         *     This is the number of the part, from 1 to 10000.  Parts are
+         *     combined in order of part number.
+         *
+         * @param[in] contents
+         *     This is the contents of the part.  Every part but the last
+         *     must be at least 5 MiB.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< UploadPartResult > UploadPart(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId,
+            unsigned int partNumber,
+            const std::string& contents
+        );
+
+        /**
+         * Store one part of an object being stored in parts, without
+         * waiting for the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3, as returned
+         *     by CreateMultipartUpload.
+         *
+         * @param[in] partNumber
+         *     This is the number of the part, from 1 to 10000.  Parts are
+         *     combined in order of part number.
+         *
+         * @param[in] contents
+         *     This is the contents of the part.  Every part but the last
+         *     must be at least 5 MiB.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void UploadPart(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId,
+            unsigned int partNumber,
+            const std::string& contents,
+            UploadPartDelegate onCompletion
+        );
+
+        /**
+         * Finish storing an object in parts, combining the given parts
+         * to form the object.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3, as returned
+         *     by CreateMultipartUpload.
+         *
+         * @param[in] parts
+         *     These identify the parts to combine to form the object,
+         *     in order of part number.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< CompleteMultipartUploadResult > CompleteMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId,
+            const std::vector< CompletedPart >& parts
+        );
+
+        /**
+         * Finish storing an object in parts, combining the given parts
+         * to form the object, without waiting for the S3 request to
+         * complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3, as returned
+         *     by CreateMultipartUpload.
+         *
+         * @param[in] parts
+         *     These identify the parts to combine to form the object,
+         *     in order of part number.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void CompleteMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId,
+            const std::vector< CompletedPart >& parts,
+            CompleteMultipartUploadDelegate onCompletion
+        );
+
+        /**
+         * Abandon storing an object in parts, discarding any parts
+         * already stored.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3, as returned
+         *     by CreateMultipartUpload.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 request.
+         */
+        std::future< AbortMultipartUploadResult > AbortMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId
+        );
+
+        /**
+         * Abandon storing an object in parts, discarding any parts
+         * already stored, without waiting for the S3 request to complete.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3, as returned
+         *     by CreateMultipartUpload.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request.  It's called from the thread which completes the
+         *     HTTP transaction, so it shouldn't block.
+         */
+        void AbortMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId,
+            AbortMultipartUploadDelegate onCompletion
+        );
+
+        /**
+         * Store contents supplied a piece at a time as an object in the
+         * given S3 bucket, using a multipart upload.  The contents are read
+         * a part at a time, and several parts are uploaded at once.  Each
+         * part which fails because of connection problems or server errors
+         * is tried again, up to a limit.  If any part still fails, the
+         * multipart upload is aborted, and the results are those of the
+         * last attempt to upload that part.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] contentSource
+         *     This is the function to call to read the contents to store
+         *     in the object.  It's called from threads other than the
+         *     caller's, but never for more than one part at a time,
+         *     until it returns zero.
+         *
+         * @param[in] extraHeaders
+         *     This is an optional dictionary listing extra headers to
+         *     include in the API call, such as those setting the content
+         *     type or metadata of the object.
+         *
+         * @param[in] partSize
+         *     This is the number of bytes to upload in each part.  S3
+         *     requires every part but the last to be at least 5 MiB, and
+         *     no part to be more than 5 GiB, so a size outside those
+         *     limits is raised or lowered to fit them.  S3 also allows no
+         *     more than 10000 parts, so the object may be at most 10000
+         *     times this size.  Once the contents turn out to be larger
+         *     than that, the upload is aborted, and the results report a
+         *     broken transaction.
+         *
+         * @param[in] maxPartsInFlight
+         *     This is the maximum number of parts to upload at once.
+         *     At most this many parts are held in memory at once.
+         *
+         * @param[in] maxAttemptsPerPart
+         *     This is the maximum number of times to try uploading each
+         *     part, if attempts fail because of connection problems or
+         *     server errors.  The wait before each retry is twice as long
+         *     as the one before it.
+         *
+         * @return
+         *     A future is returned which will return the results of the
+         *     S3 requests.
+         */
+        std::future< CompleteMultipartUploadResult > UploadObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            ContentSource contentSource,
+            const std::map< std::string, std::string > extraHeaders = {},
+            size_t partSize = 8388608,
+            size_t maxPartsInFlight = 4,
+            size_t maxAttemptsPerPart = 3
+        );
+
+        /**
+         * Store contents supplied a piece at a time as an object in the
+         * given S3 bucket, using a multipart upload, without waiting for
+         * the S3 requests to complete.  The contents are read a part at a
+         * time, and several parts are uploaded at once.  Each part which
+         * fails because of connection problems or server errors is tried
+         * again, up to a limit.  If any part still fails, the
+         * multipart upload is aborted, and the results are those of the
+         * last attempt to upload that part.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] contentSource
+         *     This is the function to call to read the contents to store
+         *     in the object.  It's called from threads other than the
+         *     caller's, but never for more than one part at a time,
+         *     until it returns zero.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     requests.  It's called from the thread which completes the
+         *     last HTTP transaction, so it shouldn't block.
+         *
+         * @param[in] extraHeaders
+         *     This is an optional dictionary listing extra headers to
+         *     include in the API call, such as those setting the content
+         *     type or metadata of the object.
+         *
+         * @param[in] partSize
+         *     This is the number of bytes to upload in each part.  S3
+         *     requires every part but the last to be at least 5 MiB, and
+         *     no part to be more than 5 GiB, so a size outside those
+         *     limits is raised or lowered to fit them.  S3 also allows no
+         *     more than 10000 parts, so the object may be at most 10000
+         *     times this size.  Once the contents turn out to be larger
+         *     than that, the upload is aborted, and the results report a
+         *     broken transaction.
+         *
+         * @param[in] maxPartsInFlight
+         *     This is the maximum number of parts to upload at once.
+         *     At most this many parts are held in memory at once.
+         *
+         * @param[in] maxAttemptsPerPart
+         *     This is the maximum number of times to try uploading each
+         *     part, if attempts fail because of connection problems or
+         *     server errors.  The wait before each retry is twice as long
+         *     as the one before it.
+         */
+        void UploadObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            ContentSource contentSource,
+            CompleteMultipartUploadDelegate onCompletion,
+            const std::map< std::string, std::string > extraHeaders = {},
+            size_t partSize = 8388608,
+            size_t maxPartsInFlight = 4,
+            size_t maxAttemptsPerPart = 3
+        );
+
         // Private properties
     private:
         /**
@@ -0,0 +1,347 @@
+#pragma once
+
+/**
+ * @file S3Coroutines.hpp
+ *
+ * This module declares awaitable variants of the Aws::S3 operations,
+ * for use from C++20 coroutines.  Nothing is declared unless the compiler
+ * supports coroutines.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include "S3.hpp"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#include <coroutine>
+#include <functional>
+#include <map>
+#include <stddef.h>
+#include <string>
+#include <utility>
+
+namespace Aws {
+
+    /**
+     * This is the type of object returned by the awaitable variants of the
+     * S3 operations.  Awaiting it starts the operation and suspends the
+     * coroutine, which is resumed from the completion delegate of the
+     * operation, on the thread which completes the HTTP transaction.
+     * No thread is blocked while the operation is in progress.
+     *
+     * @note
+     *     Each object may be awaited only once.
+     */
+    template< typename Result > class S3Awaitable {
+        // Types
+    public:
+        /**
+         * This is the type of function which starts the operation,
+         * arranging for the given delegate to be called with its results.
+         */
+        typedef std::function< void(std::function< void(Result result) > onCompletion) > Starter;
+
+        // Public methods
+    public:
+        /**
+         * This constructor sets up the object to start an operation
+         * once it's awaited.
+         *
+         * @param[in] starter
+         *     This is the function to call to start the operation.
+         */
+        explicit S3Awaitable(Starter starter)
+            : starter_(std::move(starter))
+        {
+        }
+
+        /**
+         * This is called to determine whether or not the coroutine needs
+         * to be suspended.  It always does, since the operation isn't
+         * started until the object is awaited.
+         *
+         * @return
+         *     An indication of whether or not the results are already
+         *     available is returned.
+         */
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        /**
+         * This is called once the coroutine is suspended, to start the
+         * operation.
+         *
+         * @param[in] coroutine
+         *     This is the coroutine to resume once the operation is
+         *     complete.
+         */
+        void await_suspend(std::coroutine_handle<> coroutine) {
+            // The coroutine may be resumed, and this object destroyed,
+            // before the starter returns, so take the starter (and
+            // everything it captured) out of this object first, and touch
+            // nothing in this object after the call.
+            auto starter = std::move(starter_);
+            starter(
+                [this, coroutine](Result result){
+                    result_ = std::move(result);
+                    coroutine.resume();
+                }
+            );
+        }
+
+        /**
+         * This is called once the coroutine is resumed, to provide the
+         * results of the operation as the value of the await expression.
+         *
+         * @return
+         *     The results of the operation are returned.
+         */
+        Result await_resume() {
+            return std::move(result_);
+        }
+
+        // Private properties
+    private:
+        /**
+         * This is the function to call to start the operation.
+         */
+        Starter starter_;
+
+        /**
+         * This holds the results of the operation, once it's complete.
+         */
+        Result result_;
+    };
+
+    /**
+     * Retrieve the list of the S3 buckets available to the user.
+     *
+     * @param[in] s3
+     *     This is the S3 object to use to make the request.  It must
+     *     remain valid until the awaitable is awaited.
+     *
+     * @return
+     *     An object is returned which, when awaited, makes the request
+     *     and evaluates to its results.
+     */
+    inline S3Awaitable< S3::ListBucketsResult > ListBucketsAsync(S3& s3) {
+        return S3Awaitable< S3::ListBucketsResult >(
+            [&s3](S3::ListBucketsDelegate onCompletion){
+                s3.ListBuckets(onCompletion);
+            }
+        );
+    }
+
+    /**
+     * Retrieve the list of the objects in the given S3 bucket.
+     *
+     * @param[in] s3
+     *     This is the S3 object to use to make the requests.  It must
+     *     remain valid until the awaitable is awaited.
+     *
+     * @param[in] bucketName
+     *     This is the name of the bucket whose objects should be listed.
+     *
+     * @param[in] options
+     *     These select which objects to list, and how.
+     *
+     * @return
+     *     An object is returned which, when awaited, makes the requests
+     *     and evaluates to their results.
+     */
+    inline S3Awaitable< S3::ListObjectsResult > ListObjectsAsync(
+        S3& s3,
+        const std::string& bucketName,
+        const S3::ListObjectsOptions& options = S3::ListObjectsOptions()
+    ) {
+        return S3Awaitable< S3::ListObjectsResult >(
+            [&s3, bucketName, options](S3::ListObjectsDelegate onCompletion){
+                s3.ListObjects(bucketName, options, onCompletion);
+            }
+        );
+    }
+
+    /**
+     * Retrieve one page of the list of the objects in the given S3 bucket.
+     *
+     * @param[in] s3
+     *     This is the S3 object to use to make the request.  It must
+     *     remain valid until the awaitable is awaited.
+     *
+     * @param[in] bucketName
+     *     This is the name of the bucket whose objects should be listed.
+     *
+     * @param[in] continuationToken
+     *     This identifies the page to retrieve, as given by the
+     *     previous page.  If empty, the first page is retrieved.
+     *
+     * @param[in] options
+     *     These select which objects to list, and how.
+     *
+     * @return
+     *     An object is returned which, when awaited, makes the request
+     *     and evaluates to its results.
+     */
+    inline S3Awaitable< S3::ListObjectsPageResult > ListObjectsPageAsync(
+        S3& s3,
+        const std::string& bucketName,
+        const std::string& continuationToken = "",
+        const S3::ListObjectsOptions& options = S3::ListObjectsOptions()
+    ) {
+        return S3Awaitable< S3::ListObjectsPageResult >(
+            [&s3, bucketName, continuationToken, options](S3::ListObjectsPageDelegate onCompletion){
+                s3.ListObjectsPage(bucketName, continuationToken, options, onCompletion);
+            }
+        );
+    }
+
+    /**
+     * Retrieve the contents of an object in the given S3 bucket.
+     *
+     * @param[in] s3
+     *     This is the S3 object to use to make the request.  It must
+     *     remain valid until the awaitable is awaited.
+     *
+     * @param[in] bucketName
+     *     This is the name of the bucket containing the object.
+     *
+     * @param[in] objectName
+     *     This is the name of the object to retrieve.
+     *
+     * @return
+     *     An object is returned which, when awaited, makes the request
+     *     and evaluates to its results.
+     */
+    inline S3Awaitable< S3::GetObjectResult > GetObjectAsync(
+        S3& s3,
+        const std::string& bucketName,
+        const std::string& objectName
+    ) {
+        return S3Awaitable< S3::GetObjectResult >(
+            [&s3, bucketName, objectName](S3::GetObjectDelegate onCompletion){
+                s3.GetObject(bucketName, objectName, onCompletion);
+            }
+        );
+    }
+
+    /**
+     * Store the given contents as an object in the given S3 bucket.
+     *
+     * @param[in] s3
+     *     This is the S3 object to use to make the request.  It must
+     *     remain valid until the awaitable is awaited.
+     *
+     * @param[in] bucketName
+     *     This is the name of the bucket in which to store the object.
+     *
+     * @param[in] objectName
+     *     This is the name of the object to store.
+     *
+     * @param[in] contents
+     *     This is the contents to store in the object.  It's moved
+     *     along into the request, so passing an rvalue avoids copying
+     *     it at all.
+     *
+     * @param[in] extraHeaders
+     *     This is an optional dictionary listing extra headers to
+     *     include in the API call.
+     *
+     * @param[in] payloadSigning
+     *     This indicates how the contents should be covered by the
+     *     request signature.
+     *
+     * @return
+     *     An object is returned which, when awaited, makes the request
+     *     and evaluates to its results.
+     */
+    inline S3Awaitable< S3::PutObjectResult > PutObjectAsync(
+        S3& s3,
+        const std::string& bucketName,
+        const std::string& objectName,
+        std::string contents,
+        const std::map< std::string, std::string >& extraHeaders = {},
+        S3::PayloadSigning payloadSigning = S3::PayloadSigning::Signed
+    ) {
+        return S3Awaitable< S3::PutObjectResult >(
+            [&s3, bucketName, objectName, contents = std::move(contents), extraHeaders, payloadSigning](
+                S3::PutObjectDelegate onCompletion
+            ) mutable {
+                s3.PutObject(
+                    bucketName,
+                    objectName,
+                    std::move(contents),
+                    onCompletion,
+                    extraHeaders,
+                    payloadSigning
+                );
+            }
+        );
+    }
+
+    /**
+     * Store contents supplied a piece at a time as an object in the
+     * given S3 bucket.
+     *
+     * @param[in] s3
+     *     This is the S3 object to use to make the request.  It must
+     *     remain valid until the awaitable is awaited.
+     *
+     * @param[in] bucketName
+     *     This is the name of the bucket in which to store the object.
+     *
+     * @param[in] objectName
+     *     This is the name of the object to store.
+     *
+     * @param[in] contentSource
+     *     This is the function to call to read the contents to store
+     *     in the object.  It's called repeatedly, from a thread
+     *     other than the caller's, until it returns zero.
+     *
+     * @param[in] extraHeaders
+     *     This is an optional dictionary listing extra headers to
+     *     include in the API call.
+     *
+     * @param[in] contentLength
+     *     If known, this is the size of the contents, in bytes.
+     *
+     * @param[in] payloadSigning
+     *     This indicates how the contents should be covered by the
+     *     request signature.
+     *
+     * @return
+     *     An object is returned which, when awaited, makes the request
+     *     and evaluates to its results.
+     */
+    inline S3Awaitable< S3::PutObjectResult > PutObjectAsync(
+        S3& s3,
+        const std::string& bucketName,
+        const std::string& objectName,
+        S3::ContentSource contentSource,
+        const std::map< std::string, std::string >& extraHeaders = {},
+        size_t contentLength = 0,
+        S3::PayloadSigning payloadSigning = S3::PayloadSigning::Signed
+    ) {
+        return S3Awaitable< S3::PutObjectResult >(
+            [&s3, bucketName, objectName, contentSource, extraHeaders, contentLength, payloadSigning](
+                S3::PutObjectDelegate onCompletion
+            ){
+                s3.PutObject(
+                    bucketName,
+                    objectName,
+                    contentSource,
+                    onCompletion,
+                    extraHeaders,
+                    contentLength,
+                    payloadSigning
+                );
+            }
+        );
+    }
+
+}
+
+#endif /* __has_include(<coroutine>) */
+#endif /* __cpp_impl_coroutine */
@@ -0,0 +1,237 @@
+#pragma once
+
+/**
+ * @file S3MetricsAggregator.hpp
+ *
+ * This module declares the Aws::S3MetricsAggregator class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include "S3.hpp"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Aws {
+
+    /**
+     * This class gathers statistics about the requests made of S3, by
+     * observing an S3 object.  Counters and a histogram of latencies are
+     * kept for each kind of request.
+     *
+     * The histograms are in the style of HdrHistogram: each power of two
+     * is split into a fixed number of equally-sized buckets, so that any
+     * latency, from a nanosecond up, is recorded to within about 6% of
+     * its value, using a fixed amount of memory.
+     *
+     * Requests are recorded without any locking, using only atomic
+     * additions, so the aggregator can be shared by any number of S3
+     * objects and threads.  Taking a snapshot of the statistics never
+     * holds up requests being recorded.
+     *
+     * All methods of this class are thread-safe.
+     */
+    class S3MetricsAggregator
+        : public S3::MetricsObserver
+    {
+        // Types
+    public:
+        /**
+         * This is a copy of a histogram of latencies, taken at some point
+         * in time.
+         */
+        struct LatencyHistogram {
+            /**
+             * This is the number of bits of precision kept for each
+             * latency recorded, which is also the base 2 logarithm of
+             * the number of buckets per power of two.
+             */
+            static constexpr size_t SUB_BUCKET_BITS = 4;
+
+            /**
+             * This is the number of buckets in each histogram.
+             */
+            static constexpr size_t NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+            /**
+             * These are the number of latencies recorded in each bucket.
+             */
+            std::vector< uint64_t > counts = std::vector< uint64_t >(NUM_BUCKETS);
+
+            /**
+             * Return the index of the bucket in which the given latency
+             * is recorded.
+             *
+             * @param[in] nanoseconds
+             *     This is the latency, in nanoseconds.
+             *
+             * @return
+             *     The index of the bucket in which the given latency is
+             *     recorded is returned.
+             */
+            static size_t GetBucketIndex(uint64_t nanoseconds);
+
+            /**
+             * Return the smallest latency recorded in the given bucket.
+             *
+             * @param[in] index
+             *     This is the index of the bucket.
+             *
+             * @return
+             *     The smallest latency recorded in the given bucket, in
+             *     nanoseconds, is returned.
+             */
+            static uint64_t GetBucketLowerBound(size_t index);
+
+            /**
+             * Return the largest latency recorded in the given bucket.
+             *
+             * @param[in] index
+             *     This is the index of the bucket.
+             *
+             * @return
+             *     The largest latency recorded in the given bucket, in
+             *     nanoseconds, is returned.
+             */
+            static uint64_t GetBucketUpperBound(size_t index);
+
+            /**
+             * Return the number of latencies recorded in the histogram.
+             *
+             * @return
+             *     The number of latencies recorded in the histogram is
+             *     returned.
+             */
+            uint64_t GetCount() const;
+
+            /**
+             * Return the latency at the given percentile of those
+             * recorded in the histogram.
+             *
+             * @param[in] percentile
+             *     This is the percentile, from 0.0 to 100.0.
+             *
+             * @return
+             *     The largest latency which could have been recorded in
+             *     the bucket holding the latency at the given percentile
+             *     is returned, or zero if no latencies were recorded.
+             */
+            std::chrono::nanoseconds GetPercentile(double percentile) const;
+        };
+
+        /**
+         * This holds the statistics gathered about one kind of request.
+         */
+        struct OperationStatistics {
+            /**
+             * This is the number of requests completed.
+             */
+            uint64_t requests = 0;
+
+            /**
+             * This is the number of requests for which the HTTP
+             * transaction didn't complete, so there was no response.
+             */
+            uint64_t transactionFailures = 0;
+
+            /**
+             * This is the number of requests which got a response with a
+             * status code in the 400s.
+             */
+            uint64_t clientErrors = 0;
+
+            /**
+             * This is the number of requests which got a response with a
+             * status code in the 500s.
+             */
+            uint64_t serverErrors = 0;
+
+            /**
+             * This is the total number of retries made.
+             */
+            uint64_t retries = 0;
+
+            /**
+             * This is the total number of bytes in the bodies of the
+             * requests.
+             */
+            uint64_t bytesSent = 0;
+
+            /**
+             * This is the total number of bytes in the bodies of the
+             * responses.
+             */
+            uint64_t bytesReceived = 0;
+
+            /**
+             * This is the histogram of how long the requests took.
+             */
+            LatencyHistogram latency;
+        };
+
+        /**
+         * This is a copy of the statistics gathered about each kind of
+         * request, taken at some point in time.
+         */
+        typedef std::map< S3::Operation, OperationStatistics > Snapshot;
+
+        // Lifecycle management
+    public:
+        ~S3MetricsAggregator() noexcept;
+        S3MetricsAggregator(const S3MetricsAggregator&) = delete;
+        S3MetricsAggregator(S3MetricsAggregator&&) noexcept;
+        S3MetricsAggregator& operator=(const S3MetricsAggregator&) = delete;
+        S3MetricsAggregator& operator=(S3MetricsAggregator&&) noexcept;
+
+        // Public methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        S3MetricsAggregator();
+
+        /**
+         * Return a copy of the statistics gathered so far about each kind
+         * of request.
+         *
+         * Each counter is copied atomically, but requests may be recorded
+         * while the copy is being made, so the counters of a snapshot may
+         * not all agree with each other exactly.
+         *
+         * @return
+         *     A copy of the statistics gathered so far about each kind of
+         *     request is returned.  Kinds of request which haven't been
+         *     made are left out.
+         */
+        Snapshot GetSnapshot() const;
+
+        /**
+         * Discard all statistics gathered so far.
+         */
+        void Reset();
+
+        // S3::MetricsObserver
+    public:
+        virtual void RequestCompleted(const S3::RequestMetrics& metrics) override;
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
@@ -9,7 +9,12 @@
  * © 2018 by Richard Walters
  */
 
+#include "SigningKeyCache.hpp"
+
+#include <Http/Request.hpp>
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace Aws {
 
@@ -18,6 +23,100 @@ namespace Aws {
      * Web Services (AWS) Application Programming Interface (API) calls.
      */
     class SignApi {
+        // Types
+    public:
+        /**
+         * This holds a "canonical request" along with pieces of it
+         * which are needed again in later stages of signing the request.
+         */
+        struct CanonicalRequest {
+            /**
+             * This is the complete canonical request.
+             */
+            std::string text;
+
+            /**
+             * This is the list of names of the headers included in
+             * the signature, in canonical form, separated by semicolons.
+             */
+            std::string signedHeaders;
+
+            /**
+             * This is the hex-encoded SHA-256 hash of the request body.
+             */
+            std::string payloadHash;
+
+            /**
+             * This is the value of the request's "x-amz-date" header,
+             * in canonical form.
+             */
+            std::string dateTime;
+        };
+
+        /**
+         * This holds a "string to sign" along with the credential scope
+         * it contains, broken down into its parts, so that they don't
+         * have to be recovered again from the string in order to make
+         * the signature.
+         */
+        struct StringToSign {
+            /**
+             * This is the complete string to sign.
+             */
+            std::string text;
+
+            /**
+             * This is the date part (YYYYMMDD) of the credential scope.
+             */
+            std::string date;
+
+            /**
+             * This is the region part of the credential scope.
+             */
+            std::string region;
+
+            /**
+             * This is the service part of the credential scope.
+             */
+            std::string service;
+
+            /**
+             * This is the complete credential scope.
+             */
+            std::string credentialScope;
+        };
+
+        /**
+         * This holds everything produced while signing a request, so that
+         * it can be reused to sign request after request without making
+         * new copies of anything.
+         */
+        struct RequestSignature {
+            /**
+             * This is the canonical request made for the request.
+             */
+            CanonicalRequest canonicalRequest;
+
+            /**
+             * This is the string to sign made for the request.
+             */
+            StringToSign stringToSign;
+
+            /**
+             * This is the signature of the request, as a string of
+             * lower-case hexadecimal digits.  When the payload is sent in
+             * chunks, this is the "seed signature" used to sign the first
+             * chunk.
+             */
+            std::string signature;
+
+            /**
+             * This is the value of the "Authorization" header to add to the
+             * request.
+             */
+            std::string authorization;
+        };
+
         // Public methods
     public:
         /**
@@ -34,6 +133,43 @@ namespace Aws {
          */
         static std::string ConstructCanonicalRequest(const std::string& rawRequest);
 
+        /**
+         * This function constructs the "canonical request" which corresponds
+         * to the given API request, which has already been broken down into
+         * its parts, so that it doesn't need to be generated and parsed
+         * again just to be signed.
+         *
+         * @param[in] request
+         *     This is the API request message.
+         *
+         * @return
+         *     The corresponding canonical request, along with the pieces
+         *     of it needed in later stages of signing, is returned.
+         */
+        static CanonicalRequest ConstructCanonicalRequest(const Http::Request& request);
+
+        /**
+         * This function constructs the "canonical request" which corresponds
+         * to the given API request, storing it in the given structure.
+         *
+         * The memory already held by the given structure is reused, and
+         * working storage is kept (per thread) from one call to the next,
+         * so that when a structure is reused to sign request after request,
+         * the only memory allocated is for the copies of the path, query,
+         * and headers handed back by the request itself.
+         *
+         * @param[in] request
+         *     This is the API request message.
+         *
+         * @param[out] canonicalRequest
+         *     This is where to store the corresponding canonical request,
+         *     along with the pieces of it needed in later stages of signing.
+         */
+        static void ConstructCanonicalRequest(
+            const Http::Request& request,
+            CanonicalRequest& canonicalRequest
+        );
+
         /**
          * This function constucts the "string to sign" for the given canonical
          * AWS API request to a server in the given region for the given
@@ -96,6 +232,267 @@ namespace Aws {
             const std::string& accessKeyId,
             const std::string& accessKeySecret
         );
+
+        /**
+         * This function constucts the authorization header value for the given
+         * canonical AWS API request, using the given access key and string to
+         * sign.  The signing key is taken from the given cache, so that it
+         * only needs to be derived once per credential scope.
+         *
+         * @param[in] stringToSign
+         *     This is the string to sign in order to make the signature
+         *     included in the authorization.
+         *
+         * @param[in] canonicalRequest
+         *     This is the canonical AWS API request for which to make the
+         *     string to sign.
+         *
+         * @param[in] accessKeyId
+         *     This is the ID of the key to use to sign the request.
+         *
+         * @param[in] accessKeySecret
+         *     This is the secret value of the key to use to sign the request.
+         *
+         * @param[in,out] signingKeyCache
+         *     This is the cache from which to obtain the signing key
+         *     for the credential scope of the request.
+         *
+         * @return
+         *     The authorization value is returned.  This is added to the
+         *     original request as a header named "Authorization", before
+         *     sending the request to Amazon.
+         */
+        static std::string MakeAuthorization(
+            const std::string& stringToSign,
+            const std::string& canonicalRequest,
+            const std::string& accessKeyId,
+            const std::string& accessKeySecret,
+            SigningKeyCache& signingKeyCache
+        );
+
+        /**
+         * This function constucts the "string to sign" for the given canonical
+         * AWS API request to a server in the given region for the given
+         * service, storing it in the given structure along with the parts
+         * of the credential scope it contains.
+         *
+         * @param[in] region
+         *     This is the region of the server to which the request will
+         *     be sent.
+         *
+         * @param[in] service
+         *     This is the name of the service to which the request will
+         *     be sent.
+         *
+         * @param[in] canonicalRequest
+         *     This is the canonical AWS API request for which to make the
+         *     string to sign.
+         *
+         * @param[out] stringToSign
+         *     This is where to store the string to sign.
+         */
+        static void MakeStringToSign(
+            const std::string& region,
+            const std::string& service,
+            const CanonicalRequest& canonicalRequest,
+            StringToSign& stringToSign
+        );
+
+        /**
+         * This function constucts the authorization header value for the given
+         * canonical AWS API request, using the given access key and string to
+         * sign, taking the signing key from the given cache.  Nothing needs
+         * to be recovered by breaking apart the canonical request or string
+         * to sign.
+         *
+         * @param[in] canonicalRequest
+         *     This is the canonical AWS API request to sign.
+         *
+         * @param[in] stringToSign
+         *     This is the string to sign in order to make the signature
+         *     included in the authorization.
+         *
+         * @param[in] accessKeyId
+         *     This is the ID of the key to use to sign the request.
+         *
+         * @param[in] accessKeySecret
+         *     This is the secret value of the key to use to sign the request.
+         *
+         * @param[in,out] signingKeyCache
+         *     This is the cache from which to obtain the signing key
+         *     for the credential scope of the request.
+         *
+         * @return
+         *     The authorization value is returned.
+         */
+        static std::string MakeAuthorization(
+            const CanonicalRequest& canonicalRequest,
+            const StringToSign& stringToSign,
+            const std::string& accessKeyId,
+            const std::string& accessKeySecret,
+            SigningKeyCache& signingKeyCache
+        );
+
+        /**
+         * This function performs every stage of signing the given API request
+         * in a single pass, carrying what each stage learns on to the next
+         * stage, rather than recovering it from the text made by the
+         * previous stage.
+         *
+         * @param[in] request
+         *     This is the API request message to sign.
+         *
+         * @param[in] region
+         *     This is the region of the server to which the request will
+         *     be sent.
+         *
+         * @param[in] service
+         *     This is the name of the service to which the request will
+         *     be sent.
+         *
+         * @param[in] accessKeyId
+         *     This is the ID of the key to use to sign the request.
+         *
+         * @param[in] accessKeySecret
+         *     This is the secret value of the key to use to sign the request.
+         *
+         * @param[in,out] signingKeyCache
+         *     This is the cache from which to obtain the signing key
+         *     for the credential scope of the request.
+         *
+         * @param[out] signature
+         *     This is where to store the results of each stage of signing
+         *     the request, including the value of the "Authorization"
+         *     header to add to the request.  The memory it already holds
+         *     is reused.
+         */
+        static void SignRequest(
+            const Http::Request& request,
+            const std::string& region,
+            const std::string& service,
+            const std::string& accessKeyId,
+            const std::string& accessKeySecret,
+            SigningKeyCache& signingKeyCache,
+            RequestSignature& signature
+        );
+
+        /**
+         * This function performs the stages of signing an API request which
+         * follow the construction of its canonical request, which must
+         * already be stored in the given signature.  Together with
+         * ConstructCanonicalRequest, this does the same as SignRequest, but
+         * lets the caller tell the stages apart (for example, to time them).
+         *
+         * @param[in] region
+         *     This is the region of the server to which the request will
+         *     be sent.
+         *
+         * @param[in] service
+         *     This is the name of the service to which the request will
+         *     be sent.
+         *
+         * @param[in] accessKeyId
+         *     This is the ID of the key to use to sign the request.
+         *
+         * @param[in] accessKeySecret
+         *     This is the secret value of the key to use to sign the request.
+         *
+         * @param[in,out] signingKeyCache
+         *     This is the cache from which to obtain the signing key
+         *     for the credential scope of the request.
+         *
+         * @param[in,out] signature
+         *     On input, this holds the canonical request to sign.  On
+         *     output, it also holds the results of the remaining stages of
+         *     signing the request, including the value of the
+         *     "Authorization" header to add to the request.
+         */
+        static void SignCanonicalRequest(
+            const std::string& region,
+            const std::string& service,
+            const std::string& accessKeyId,
+            const std::string& accessKeySecret,
+            SigningKeyCache& signingKeyCache,
+            RequestSignature& signature
+        );
+
+        /**
+         * This function makes the signature of one chunk of a payload sent
+         * in chunks using the "aws-chunked" content encoding, as defined
+         * by Amazon here:
+         * https://docs.aws.amazon.com/AmazonS3/latest/API/sigv4-streaming.html.
+         *
+         * @param[in] requestSignature
+         *     This holds the results of signing the request carrying
+         *     the payload.
+         *
+         * @param[in] previousSignature
+         *     This is the signature of the previous chunk, or the
+         *     signature of the request itself, for the first chunk.
+         *
+         * @param[in] chunkHash
+         *     This is the hex-encoded SHA-256 hash of the chunk's data.
+         *
+         * @param[in] accessKeySecret
+         *     This is the secret value of the key used to sign the request.
+         *
+         * @param[in,out] signingKeyCache
+         *     This is the cache from which to obtain the signing key
+         *     for the credential scope of the request.
+         *
+         * @return
+         *     The signature of the chunk, as a string of lower-case
+         *     hexadecimal digits, is returned.
+         */
+        static std::string MakeChunkSignature(
+            const RequestSignature& requestSignature,
+            const std::string& previousSignature,
+            const std::string& chunkHash,
+            const std::string& accessKeySecret,
+            SigningKeyCache& signingKeyCache
+        );
+
+        /**
+         * This function derives the key used to sign requests for the given
+         * credential scope, as defined by Amazon here:
+         * https://docs.aws.amazon.com/general/latest/gr/sigv4-calculate-signature.html.
+         *
+         * @param[in] accessKeySecret
+         *     This is the secret value of the key to use to sign requests.
+         *
+         * @param[in] date
+         *     This is the date part (YYYYMMDD) of the credential scope.
+         *
+         * @param[in] region
+         *     This is the region part of the credential scope.
+         *
+         * @param[in] service
+         *     This is the service part of the credential scope.
+         *
+         * @return
+         *     The signing key for the given credential scope is returned.
+         */
+        static std::vector< uint8_t > MakeSigningKey(
+            const std::string& accessKeySecret,
+            const std::string& date,
+            const std::string& region,
+            const std::string& service
+        );
+
+        /**
+         * This function encodes the given string according to Amazon's
+         * notion of what it means to "URI Encode" something, where every
+         * character other than the "unreserved" ones of RFC 3986 is
+         * percent-encoded.  This is how names and values in the query of
+         * a request should be encoded.
+         *
+         * @param[in] s
+         *     This is the string to encode.
+         *
+         * @return
+         *     The encoded string is returned.
+         */
+        static std::string AmzUriEncode(const std::string& s);
     };
 
 }
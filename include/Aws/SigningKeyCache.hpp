@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file SigningKeyCache.hpp
+ *
+ * This module declares the Aws::SigningKeyCache class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Aws {
+
+    /**
+     * This class remembers signing keys derived from an access key secret
+     * for a given credential scope (date, region, and service), so that
+     * the chain of HMAC operations used to derive them only has to be
+     * performed once per scope rather than once per request.
+     *
+     * Because the date is part of the credential scope, keys naturally
+     * expire at the UTC day boundary.  Whenever a key for a newer date is
+     * derived, keys for older dates are discarded.
+     *
+     * All methods of this class are thread-safe.
+     */
+    class SigningKeyCache {
+        // Lifecycle management
+    public:
+        ~SigningKeyCache() noexcept;
+        SigningKeyCache(const SigningKeyCache&) = delete;
+        SigningKeyCache(SigningKeyCache&&) noexcept;
+        SigningKeyCache& operator=(const SigningKeyCache&) = delete;
+        SigningKeyCache& operator=(SigningKeyCache&&) noexcept;
+
+        // Public methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        SigningKeyCache();
+
+        /**
+         * Return the signing key for the given access key secret and
+         * credential scope, deriving and remembering it if it isn't
+         * already known.
+         *
+         * @param[in] accessKeySecret
+         *     This is the secret value of the key used to sign requests.
+         *
+         * @param[in] date
+         *     This is the date part (YYYYMMDD) of the credential scope.
+         *
+         * @param[in] region
+         *     This is the region part of the credential scope.
+         *
+         * @param[in] service
+         *     This is the service part of the credential scope.
+         *
+         * @return
+         *     The signing key for the given secret and scope is returned.
+         */
+        std::vector< uint8_t > GetSigningKey(
+            const std::string& accessKeySecret,
+            const std::string& date,
+            const std::string& region,
+            const std::string& service
+        );
+
+        /**
+         * Return the number of signing keys currently remembered.
+         *
+         * @return
+         *     The number of signing keys currently remembered is returned.
+         */
+        size_t GetSize() const;
+
+        /**
+         * Forget all remembered signing keys.
+         */
+        void Clear();
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
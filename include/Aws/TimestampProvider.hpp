@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * @file TimestampProvider.hpp
+ *
+ * This module declares the Aws::TimestampProvider class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <time.h>
+
+namespace Aws {
+
+    /**
+     * This class provides the current time formatted as AWS expects it in
+     * the "x-amz-date" header of a request, in the ISO-8601 format
+     * YYYYMMDD'T'HHMMSS'Z'.
+     *
+     * The formatted time is remembered, so that it only has to be worked
+     * out once per second no matter how many requests are made in that
+     * second.  Retrieving it never blocks: if another thread happens to be
+     * updating the remembered time, the caller simply formats the time
+     * itself.
+     *
+     * All methods of this class are thread-safe.
+     */
+    class TimestampProvider {
+        // Types
+    public:
+        /**
+         * This is the type of function used to get the current time, in
+         * seconds since the UNIX epoch (Midnight UTC January 1, 1970).
+         */
+        typedef std::function< time_t() > Clock;
+
+        // Lifecycle management
+    public:
+        ~TimestampProvider() noexcept;
+        TimestampProvider(const TimestampProvider&) = delete;
+        TimestampProvider(TimestampProvider&&) noexcept;
+        TimestampProvider& operator=(const TimestampProvider&) = delete;
+        TimestampProvider& operator=(TimestampProvider&&) noexcept;
+
+        // Public methods
+    public:
+        /**
+         * This is the default constructor.  The provider uses the system
+         * clock to get the current time.
+         */
+        TimestampProvider();
+
+        /**
+         * This constructor sets up the provider to use the given function
+         * to get the current time.
+         *
+         * @param[in] clock
+         *     This is the function to call to get the current time.
+         */
+        explicit TimestampProvider(Clock clock);
+
+        /**
+         * Return the current time, in the format used by AWS.
+         *
+         * @return
+         *     The current time, formatted in the ISO-8601 format
+         *     YYYYMMDD'T'HHMMSS'Z', is returned.
+         */
+        std::string GetTimestamp();
+
+        /**
+         * Convert the given time from seconds since the UNIX epoch to the
+         * ISO-8601 format YYYYMMDD'T'HHMMSS'Z' expected by AWS.
+         *
+         * Unlike gmtime, this is safe to call from any number of threads
+         * at once.
+         *
+         * @param[in] time
+         *     This is the time in seconds since the UNIX epoch.
+         *
+         * @return
+         *     The given time, formatted in the ISO-8601 format
+         *     YYYYMMDD'T'HHMMSS'Z', is returned.
+         */
+        static std::string FormatTimestamp(time_t time);
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
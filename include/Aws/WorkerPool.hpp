@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file WorkerPool.hpp
+ *
+ * This module declares the Aws::WorkerPool class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stddef.h>
+
+namespace Aws {
+
+    /**
+     * This class runs tasks on a fixed number of worker threads, so that
+     * the number of threads used doesn't grow with the number of tasks.
+     * Tasks are run in the order in which they are posted, as workers
+     * become available.
+     *
+     * When the pool is destroyed, any tasks still waiting, including
+     * delayed tasks which aren't yet due, are run before the workers exit.
+     *
+     * All methods of this class are thread-safe.
+     */
+    class WorkerPool {
+        // Lifecycle management
+    public:
+        ~WorkerPool() noexcept;
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool(WorkerPool&&) noexcept;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+        WorkerPool& operator=(WorkerPool&&) noexcept;
+
+        // Public methods
+    public:
+        /**
+         * This constructor starts the worker threads.
+         *
+         * @param[in] numWorkers
+         *     This is the number of worker threads to start.
+         *     At least one worker is always started.
+         */
+        explicit WorkerPool(size_t numWorkers);
+
+        /**
+         * Queue the given task to be run by the next available worker.
+         *
+         * @param[in] task
+         *     This is the task to run.
+         */
+        void Post(std::function< void() > task);
+
+        /**
+         * Queue the given task to be run by the next available worker,
+         * once the given amount of time has passed.  No worker is tied up
+         * while the task waits.
+         *
+         * @param[in] task
+         *     This is the task to run.
+         *
+         * @param[in] delay
+         *     This is how long to wait before the task may be run.
+         */
+        void PostDelayed(
+            std::function< void() > task,
+            std::chrono::milliseconds delay
+        );
+
+        /**
+         * Return the number of worker threads in the pool.
+         *
+         * @return
+         *     The number of worker threads in the pool is returned.
+         */
+        size_t GetSize() const;
+
+        // Private properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::shared_ptr< Impl > impl_;
+    };
+
+}
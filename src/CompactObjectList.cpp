@@ -0,0 +1,203 @@
+/**
+ * @file CompactObjectList.cpp
+ *
+ * This module contains the implementation of the Aws::CompactObjectList
+ * structure.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <Aws/CompactObjectList.hpp>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace {
+
+    /**
+     * Return the value of the given hexadecimal digit.
+     *
+     * @param[in] c
+     *     This is the hexadecimal digit.
+     *
+     * @return
+     *     The value of the digit is returned, or -1 if the character
+     *     isn't a hexadecimal digit.
+     */
+    int HexDigitValue(char c) {
+        if ((c >= '0') && (c <= '9')) {
+            return c - '0';
+        } else if ((c >= 'a') && (c <= 'f')) {
+            return c - 'a' + 10;
+        } else if ((c >= 'A') && (c <= 'F')) {
+            return c - 'A' + 10;
+        } else {
+            return -1;
+        }
+    }
+
+    /**
+     * Parse the given entity tag, which should consist of a 128-bit
+     * digest in hexadecimal, optionally followed by a dash and a part
+     * count.
+     *
+     * @param[in] eTag
+     *     This points to the entity tag, without quotation marks.
+     *
+     * @param[in] eTagLength
+     *     This is the number of characters in the entity tag.
+     *
+     * @param[out] digest
+     *     This is where to store the digest.
+     *
+     * @param[out] partCount
+     *     This is where to store the part count, or zero if there is none.
+     *
+     * @return
+     *     An indication of whether or not the entity tag has the expected
+     *     form is returned.
+     */
+    bool ParseETag(
+        const char* eTag,
+        size_t eTagLength,
+        Aws::CompactObjectList::Digest& digest,
+        uint32_t& partCount
+    ) {
+        if (eTagLength < digest.size() * 2) {
+            return false;
+        }
+        for (size_t i = 0; i < digest.size(); ++i) {
+            const auto high = HexDigitValue(eTag[i * 2]);
+            const auto low = HexDigitValue(eTag[i * 2 + 1]);
+            if ((high < 0) || (low < 0)) {
+                return false;
+            }
+            digest[i] = (uint8_t)((high << 4) | low);
+        }
+        partCount = 0;
+        if (eTagLength == digest.size() * 2) {
+            return true;
+        }
+        if (
+            (eTag[digest.size() * 2] != '-')
+            || (eTagLength == digest.size() * 2 + 1)
+            || (eTagLength > digest.size() * 2 + 11)
+        ) {
+            return false;
+        }
+        uint64_t count = 0;
+        for (size_t i = digest.size() * 2 + 1; i < eTagLength; ++i) {
+            const auto c = eTag[i];
+            if ((c < '0') || (c > '9')) {
+                return false;
+            }
+            count = count * 10 + (uint64_t)(c - '0');
+        }
+        if (
+            (count == 0)
+            || (count > UINT32_MAX)
+        ) {
+            return false;
+        }
+        partCount = (uint32_t)count;
+        return true;
+    }
+
+}
+
+namespace Aws {
+
+    size_t CompactObjectList::GetSize() const {
+        return keyOffsets.size();
+    }
+
+    const char* CompactObjectList::GetKeyData(size_t index) const {
+        return keys.data() + keyOffsets[index];
+    }
+
+    size_t CompactObjectList::GetKeyLength(size_t index) const {
+        const auto end = (
+            (index + 1 < keyOffsets.size())
+            ? keyOffsets[index + 1]
+            : keys.length()
+        );
+        return end - keyOffsets[index];
+    }
+
+    std::string CompactObjectList::GetKey(size_t index) const {
+        return std::string(GetKeyData(index), GetKeyLength(index));
+    }
+
+    std::string CompactObjectList::GetETag(size_t index) const {
+        if (!irregularETags.empty()) {
+            const auto irregularETag = irregularETags.find(index);
+            if (irregularETag != irregularETags.end()) {
+                return irregularETag->second;
+            }
+        }
+        static const char hexDigits[] = "0123456789abcdef";
+        std::string eTag;
+        eTag.reserve(eTagDigests[index].size() * 2 + 11);
+        for (const auto byte: eTagDigests[index]) {
+            eTag.push_back(hexDigits[byte >> 4]);
+            eTag.push_back(hexDigits[byte & 0x0F]);
+        }
+        if (eTagPartCounts[index] != 0) {
+            eTag.push_back('-');
+            eTag += std::to_string(eTagPartCounts[index]);
+        }
+        return eTag;
+    }
+
+    void CompactObjectList::Add(
+        const char* key,
+        size_t keyLength,
+        const char* eTag,
+        size_t eTagLength,
+        int64_t lastModifiedMilliseconds,
+        uint64_t size
+    ) {
+        if (
+            (eTagLength >= 2)
+            && (eTag[0] == '"')
+            && (eTag[eTagLength - 1] == '"')
+        ) {
+            ++eTag;
+            eTagLength -= 2;
+        }
+        const auto index = keyOffsets.size();
+        keyOffsets.push_back(keys.length());
+        keys.append(key, keyLength);
+        Digest digest;
+        uint32_t partCount;
+        if (!ParseETag(eTag, eTagLength, digest, partCount)) {
+            digest.fill(0);
+            partCount = 0;
+            irregularETags[index] = std::string(eTag, eTagLength);
+        }
+        eTagDigests.push_back(digest);
+        eTagPartCounts.push_back(partCount);
+        lastModified.push_back(lastModifiedMilliseconds);
+        sizes.push_back(size);
+    }
+
+    void CompactObjectList::Reserve(size_t numObjects, size_t totalKeyLength) {
+        keys.reserve(totalKeyLength);
+        keyOffsets.reserve(numObjects);
+        eTagDigests.reserve(numObjects);
+        eTagPartCounts.reserve(numObjects);
+        lastModified.reserve(numObjects);
+        sizes.reserve(numObjects);
+    }
+
+    void CompactObjectList::Clear() {
+        keys.clear();
+        keyOffsets.clear();
+        eTagDigests.clear();
+        eTagPartCounts.clear();
+        lastModified.clear();
+        sizes.clear();
+        irregularETags.clear();
+    }
+
+}
@@ -0,0 +1,165 @@
+/**
+ * @file IncrementalSha256.cpp
+ *
+ * This module contains the implementation of the Aws::IncrementalSha256
+ * class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include "IncrementalSha256.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+    /**
+     * These are the round constants defined for SHA-256 in FIPS 180-4,
+     * section 4.2.2.
+     */
+    const uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+    };
+
+    /**
+     * This function rotates the given value right by the given number
+     * of bits.
+     *
+     * @param[in] value
+     *     This is the value to rotate.
+     *
+     * @param[in] bits
+     *     This is the number of bits by which to rotate the value.
+     *
+     * @return
+     *     The rotated value is returned.
+     */
+    uint32_t RotateRight(uint32_t value, int bits) {
+        return (value >> bits) | (value << (32 - bits));
+    }
+
+}
+
+namespace Aws {
+
+    IncrementalSha256::IncrementalSha256() {
+        Reset();
+    }
+
+    void IncrementalSha256::Reset() {
+        static const uint32_t initialState[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+        };
+        (void)memcpy(state_, initialState, sizeof(state_));
+        bufferLength_ = 0;
+        messageLength_ = 0;
+    }
+
+    void IncrementalSha256::Append(const void* data, size_t length) {
+        auto bytes = (const uint8_t*)data;
+        messageLength_ += length;
+        while (length > 0) {
+            const auto amount = std::min(length, sizeof(buffer_) - bufferLength_);
+            (void)memcpy(buffer_ + bufferLength_, bytes, amount);
+            bufferLength_ += amount;
+            bytes += amount;
+            length -= amount;
+            if (bufferLength_ == sizeof(buffer_)) {
+                ProcessBlock();
+                bufferLength_ = 0;
+            }
+        }
+    }
+
+    void IncrementalSha256::Append(const std::string& data) {
+        Append(data.data(), data.length());
+    }
+
+    std::string IncrementalSha256::FinishAsHex() {
+        const auto messageLengthInBits = messageLength_ * 8;
+        buffer_[bufferLength_++] = 0x80;
+        if (bufferLength_ > sizeof(buffer_) - 8) {
+            (void)memset(buffer_ + bufferLength_, 0, sizeof(buffer_) - bufferLength_);
+            ProcessBlock();
+            bufferLength_ = 0;
+        }
+        (void)memset(buffer_ + bufferLength_, 0, sizeof(buffer_) - 8 - bufferLength_);
+        for (size_t i = 0; i < 8; ++i) {
+            buffer_[sizeof(buffer_) - 1 - i] = (uint8_t)(messageLengthInBits >> (i * 8));
+        }
+        ProcessBlock();
+        static const char hexDigits[] = "0123456789abcdef";
+        std::string digest(64, '0');
+        for (size_t i = 0; i < 8; ++i) {
+            for (size_t j = 0; j < 8; ++j) {
+                digest[i * 8 + j] = hexDigits[(state_[i] >> (28 - j * 4)) & 0x0F];
+            }
+        }
+        return digest;
+    }
+
+    std::string IncrementalSha256::HashAsHex(const std::string& data) {
+        IncrementalSha256 hash;
+        hash.Append(data);
+        return hash.FinishAsHex();
+    }
+
+    void IncrementalSha256::ProcessBlock() {
+        uint32_t w[64];
+        for (size_t i = 0; i < 16; ++i) {
+            w[i] = (
+                ((uint32_t)buffer_[i * 4] << 24)
+                | ((uint32_t)buffer_[i * 4 + 1] << 16)
+                | ((uint32_t)buffer_[i * 4 + 2] << 8)
+                | (uint32_t)buffer_[i * 4 + 3]
+            );
+        }
+        for (size_t i = 16; i < 64; ++i) {
+            const auto s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const auto s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        auto a = state_[0];
+        auto b = state_[1];
+        auto c = state_[2];
+        auto d = state_[3];
+        auto e = state_[4];
+        auto f = state_[5];
+        auto g = state_[6];
+        auto h = state_[7];
+        for (size_t i = 0; i < 64; ++i) {
+            const auto s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+            const auto ch = (e & f) ^ (~e & g);
+            const auto temp1 = h + s1 + ch + K[i] + w[i];
+            const auto s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+            const auto maj = (a & b) ^ (a & c) ^ (b & c);
+            const auto temp2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        state_[0] += a;
+        state_[1] += b;
+        state_[2] += c;
+        state_[3] += d;
+        state_[4] += e;
+        state_[5] += f;
+        state_[6] += g;
+        state_[7] += h;
+    }
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file IncrementalSha256.hpp
+ *
+ * This module declares the Aws::IncrementalSha256 class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace Aws {
+
+    /**
+     * This class computes the Secure Hash Algorithm 2 (SHA-2) 256-bit
+     * message digest of data supplied a piece at a time, so that large
+     * amounts of data can be hashed as they become available, without
+     * first being gathered together or copied.
+     */
+    class IncrementalSha256 {
+        // Public methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        IncrementalSha256();
+
+        /**
+         * Begin computing a new message digest, discarding any data
+         * given so far.
+         */
+        void Reset();
+
+        /**
+         * Add the given data to the message being digested.
+         *
+         * @param[in] data
+         *     This points to the data to add.
+         *
+         * @param[in] length
+         *     This is the number of bytes of data to add.
+         */
+        void Append(const void* data, size_t length);
+
+        /**
+         * Add the given data to the message being digested.
+         *
+         * @param[in] data
+         *     This is the data to add.
+         */
+        void Append(const std::string& data);
+
+        /**
+         * Complete the message digest and return it in hexadecimal form.
+         * After this, Reset must be called before digesting another
+         * message.
+         *
+         * @return
+         *     The message digest, as a string of lower-case hexadecimal
+         *     digits, is returned.
+         */
+        std::string FinishAsHex();
+
+        /**
+         * Compute the message digest of the given data, in hexadecimal
+         * form, in one step.
+         *
+         * @param[in] data
+         *     This is the data to digest.
+         *
+         * @return
+         *     The message digest, as a string of lower-case hexadecimal
+         *     digits, is returned.
+         */
+        static std::string HashAsHex(const std::string& data);
+
+        // Private methods
+    private:
+        /**
+         * Fold the block currently held in the buffer into the state
+         * of the message digest.
+         */
+        void ProcessBlock();
+
+        // Private properties
+    private:
+        /**
+         * This is the intermediate state of the message digest.
+         */
+        uint32_t state_[8];
+
+        /**
+         * This holds data that hasn't been folded into the message digest
+         * yet, because there isn't a complete block of it.
+         */
+        uint8_t buffer_[64];
+
+        /**
+         * This is the number of bytes currently held in the buffer.
+         */
+        size_t bufferLength_ = 0;
+
+        /**
+         * This is the total number of bytes of message given so far.
+         */
+        uint64_t messageLength_ = 0;
+    };
+
+}
@@ -6,34 +6,226 @@
  * © 2019 by Richard Walters
  */
 
+#include "IncrementalSha256.hpp"
+#include "XmlParser.hpp"
+
+#include <algorithm>
 #include <Aws/S3.hpp>
 #include <Aws/SignApi.hpp>
+#include <Aws/SigningKeyCache.hpp>
+#include <Aws/TimestampProvider.hpp>
+#include <Aws/WorkerPool.hpp>
+#include <chrono>
+#include <functional>
 #include <future>
+#include <iterator>
 #include <Json/Value.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
-#include <stack>
+#include <stdint.h>
 #include <stdio.h>
 #include <string>
+#include <string.h>
 #include <StringExtensions/StringExtensions.hpp>
-#include <time.h>
+#include <vector>
 
 namespace {
 
     /**
-     * This function converts the given time from seconds since the UNIX epoch
-     * to the ISO-8601 format YYYYMMDD'T'HHMMSS'Z' expected by AWS.
+     * This is the number of worker threads started to carry out S3
+     * requests, if no worker pool is provided when configuring the S3
+     * object.
+     */
+    constexpr size_t DEFAULT_WORKER_POOL_SIZE = 16;
+
+    /**
+     * This is the value of the "x-amz-content-sha256" header which
+     * indicates the payload is not included in the signature.
+     */
+    const char* const UNSIGNED_PAYLOAD = "UNSIGNED-PAYLOAD";
+
+    /**
+     * This is the value of the "x-amz-content-sha256" header which
+     * indicates the payload is sent in signed chunks, using the
+     * "aws-chunked" content encoding.
+     */
+    const char* const STREAMING_PAYLOAD = "STREAMING-AWS4-HMAC-SHA256-PAYLOAD";
+
+    /**
+     * This is what comes between the size and signature of each chunk of
+     * a payload sent using the "aws-chunked" content encoding.
+     */
+    const char CHUNK_SIGNATURE_PREFIX[] = ";chunk-signature=";
+
+    /**
+     * This is the number of bytes of payload data to put in each chunk,
+     * when sending a payload using the "aws-chunked" content encoding.
+     */
+    constexpr size_t CHUNK_SIZE = 65536;
+
+    /**
+     * This is the number of hexadecimal digits in a chunk signature.
+     */
+    constexpr size_t CHUNK_SIGNATURE_LENGTH = 64;
+
+    /**
+     * This is the smallest size S3 allows for any part of a multipart
+     * upload other than the last.
+     */
+    constexpr size_t MIN_UPLOAD_PART_SIZE = 5 * 1024 * 1024;
+
+    /**
+     * This is the largest size S3 allows for any part of a multipart
+     * upload.
+     */
+    constexpr uint64_t MAX_UPLOAD_PART_SIZE = 5ULL * 1024 * 1024 * 1024;
+
+    /**
+     * This is the largest number of parts S3 allows in a multipart
+     * upload.
+     */
+    constexpr unsigned int MAX_UPLOAD_PARTS = 10000;
+
+    /**
+     * This is how long to wait before the first retry of a failed
+     * request.  The wait doubles with each retry after that.
+     */
+    constexpr std::chrono::milliseconds RETRY_BASE_DELAY(100);
+
+    /**
+     * This is the longest to wait before retrying a failed request.
+     */
+    constexpr std::chrono::milliseconds RETRY_MAX_DELAY(10000);
+
+    /**
+     * This is how long the task currently being carried out by this
+     * thread for an S3 object waited in the worker pool before it
+     * started.  It's handed on to the first request made by the task.
+     */
+    thread_local std::chrono::nanoseconds queueWaitOfTask = std::chrono::nanoseconds::zero();
+
+    /**
+     * This is the number of attempts which failed before the next request
+     * this thread makes, which is a retry of the same request.  It's
+     * handed on to the next request made.
+     */
+    thread_local size_t retriesOfNextRequest = 0;
+
+    /**
+     * This is where information about a request, such as the times taken
+     * by each stage of preparing it, is collected by this thread, as the
+     * request is made, signed, and handed to the HTTP client.
+     */
+    thread_local Aws::S3::RequestMetrics metricsOfRequestBeingMade;
+
+    /**
+     * This is when the work which made the request currently being made
+     * by this thread was queued, or when the request was started, if it
+     * wasn't made by work queued in the worker pool.
+     */
+    thread_local std::chrono::steady_clock::time_point startOfRequestBeingMade;
+
+    /**
+     * This is the total time this thread has spent parsing the body of
+     * the response currently being handled.
+     */
+    thread_local std::chrono::nanoseconds timeSpentParsing = std::chrono::nanoseconds::zero();
+
+    /**
+     * An instance of this class adds the time from its construction
+     * until its destruction to the total time spent parsing the body of
+     * the response currently being handled.
+     */
+    class ParsingTimer {
+        // Lifecycle management
+    public:
+        ~ParsingTimer() noexcept {
+            timeSpentParsing += std::chrono::steady_clock::now() - start_;
+        }
+        ParsingTimer(const ParsingTimer&) = delete;
+        ParsingTimer(ParsingTimer&&) = delete;
+        ParsingTimer& operator=(const ParsingTimer&) = delete;
+        ParsingTimer& operator=(ParsingTimer&&) = delete;
+
+        // Public methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        ParsingTimer() = default;
+
+        // Private properties
+    private:
+        /**
+         * This is when the timer was constructed.
+         */
+        std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+    };
+
+    /**
+     * This function computes the size of a payload of the given size
+     * once it's encoded using the "aws-chunked" content encoding.
+     *
+     * @param[in] decodedLength
+     *     This is the size of the payload before encoding.
+     *
+     * @return
+     *     The size of the encoded payload is returned.
+     */
+    size_t GetChunkedContentLength(size_t decodedLength) {
+        const auto getEncodedChunkLength = [](size_t chunkLength){
+            return (
+                StringExtensions::sprintf("%zx", chunkLength).length()
+                + sizeof(CHUNK_SIGNATURE_PREFIX) - 1
+                + CHUNK_SIGNATURE_LENGTH
+                + 2
+                + chunkLength
+                + 2
+            );
+        };
+        const auto fullChunks = decodedLength / CHUNK_SIZE;
+        const auto lastChunkLength = decodedLength % CHUNK_SIZE;
+        auto encodedLength = fullChunks * getEncodedChunkLength(CHUNK_SIZE);
+        if (lastChunkLength > 0) {
+            encodedLength += getEncodedChunkLength(lastChunkLength);
+        }
+        encodedLength += getEncodedChunkLength(0);
+        return encodedLength;
+    }
+
+    /**
+     * This function reads from the given content source until either the
+     * given buffer is full or the end of the content is reached.
+     *
+     * @param[in] contentSource
+     *     This is the function to call to read content.
      *
-     * @param[in] time
-     *     This is the time in seconds since the UNIX epoch.
+     * @param[out] buffer
+     *     This is where to place the content read.
+     *
+     * @param[in] bufferSize
+     *     This is the number of bytes to read.
      *
      * @return
-     *     The given time, formatted in the ISO-8601 format
-     *     YYYYMMDD'T'HHMMSS'Z', is returned.
+     *     The number of bytes read is returned.  This is less than the
+     *     buffer size only if the end of the content is reached.
      */
-    std::string AmzTimestamp(time_t time) {
-        char buffer[17];
-        (void)strftime(buffer, sizeof(buffer), "%Y%m%dT%H%M%SZ", gmtime(&time));
-        return buffer;
+    size_t ReadFully(
+        const Aws::S3::ContentSource& contentSource,
+        char* buffer,
+        size_t bufferSize
+    ) {
+        size_t amountRead = 0;
+        while (amountRead < bufferSize) {
+            const auto amount = contentSource(buffer + amountRead, bufferSize - amountRead);
+            if (amount == 0) {
+                break;
+            }
+            amountRead += amount;
+        }
+        return amountRead;
     }
 
     /**
@@ -70,6 +262,158 @@ namespace {
         return values;
     }
 
+    /**
+     * This function parses the value of a "Content-Range" header of a
+     * response to a request for a range of bytes.
+     *
+     * @param[in] contentRange
+     *     This is the value of the "Content-Range" header.
+     *
+     * @param[out] first
+     *     This is where to store the offset of the first byte provided.
+     *
+     * @param[out] last
+     *     This is where to store the offset of the last byte provided.
+     *
+     * @param[out] totalSize
+     *     This is where to store the size of the whole resource.
+     *
+     * @return
+     *     An indication of whether or not the header value could be
+     *     parsed is returned.
+     */
+    bool ParseContentRange(
+        const std::string& contentRange,
+        size_t& first,
+        size_t& last,
+        size_t& totalSize
+    ) {
+        return (
+            (
+                sscanf(
+                    contentRange.c_str(),
+                    "bytes %zu-%zu/%zu",
+                    &first,
+                    &last,
+                    &totalSize
+                ) == 3
+            )
+            && (first <= last)
+            && (last < totalSize)
+        );
+    }
+
+    /**
+     * Parse the decimal number at the given position in a string,
+     * advancing the position past it.
+     *
+     * @param[in,out] next
+     *     This points to the next character to parse.  On return, it
+     *     points to the first character after the number.
+     *
+     * @param[in] end
+     *     This points just past the last character of the string.
+     *
+     * @param[out] value
+     *     This is where to store the value of the number.
+     *
+     * @return
+     *     An indication of whether or not there was a number to parse
+     *     is returned.
+     */
+    bool ParseTimestampField(const char*& next, const char* end, int& value) {
+        const auto begin = next;
+        value = 0;
+        while (
+            (next != end)
+            && (*next >= '0')
+            && (*next <= '9')
+            && (next - begin < 9)
+        ) {
+            value = value * 10 + (*next++ - '0');
+        }
+        return (next != begin);
+    }
+
+    /**
+     * Parse the given time in UTC, in the ISO 8601 format used by S3
+     * (for example, "2019-03-03T05:22:16.121Z"), into the equivalent whole
+     * number of seconds since the UNIX epoch (Midnight UTC January 1,
+     * 1970), and the number after the decimal point.
+     *
+     * The date is converted to a day number directly, using the
+     * "days from civil" algorithm by Howard Hinnant, rather than by adding
+     * up the lengths of the years and months since the epoch.
+     *
+     * @param[in] timestamp
+     *     This points to the timestamp to parse.
+     *
+     * @param[in] length
+     *     This is the number of characters in the timestamp.
+     *
+     * @param[out] seconds
+     *     This is where to store the whole number of seconds since the
+     *     UNIX epoch.
+     *
+     * @param[out] fraction
+     *     This is where to store the number after the decimal point, if
+     *     any, which S3 gives as a number of milliseconds.
+     *
+     * @return
+     *     An indication of whether or not the timestamp could be parsed
+     *     is returned.
+     */
+    bool ParseTimestamp(
+        const char* timestamp,
+        size_t length,
+        int64_t& seconds,
+        int& fraction
+    ) {
+        seconds = 0;
+        fraction = 0;
+        const auto end = timestamp + length;
+        auto next = timestamp;
+        int fields[6];
+        static const char separators[] = "--T::";
+        for (size_t i = 0; i < 6; ++i) {
+            if (!ParseTimestampField(next, end, fields[i])) {
+                return false;
+            }
+            if (i < 5) {
+                if (
+                    (next == end)
+                    || (*next++ != separators[i])
+                ) {
+                    return false;
+                }
+            }
+        }
+        if (
+            (next != end)
+            && (*next == '.')
+        ) {
+            ++next;
+            if (!ParseTimestampField(next, end, fraction)) {
+                return false;
+            }
+        }
+        const auto year = (int64_t)fields[0] - ((fields[1] <= 2) ? 1 : 0);
+        const auto month = (int64_t)fields[1];
+        const auto day = (int64_t)fields[2];
+        const auto era = year / 400;
+        const auto yearOfEra = year - era * 400;
+        const auto dayOfYear = (153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5 + day - 1;
+        const auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        const auto daysSinceEpoch = era * 146097 + dayOfEra - 719468;
+        seconds = (
+            daysSinceEpoch * 86400
+            + (int64_t)fields[3] * 3600
+            + (int64_t)fields[4] * 60
+            + (int64_t)fields[5]
+        );
+        return true;
+    }
+
     /**
      * Convert the given time in UTC to the equivalent number of seconds
      * since the UNIX epoch (Midnight UTC January 1, 1970).
@@ -82,47 +426,145 @@ namespace {
      *     is returned.
      */
     double ParseTimestamp(const std::string& timestamp) {
-        int years, months, days, hours, minutes, seconds, milliseconds;
-        (void)sscanf(
-            timestamp.c_str(),
-            "%d-%d-%dT%d:%d:%d.%dZ",
-            &years,
-            &months,
-            &days,
-            &hours,
-            &minutes,
-            &seconds,
-            &milliseconds
-        );
-        static const auto isLeapYear = [](int year){
-            if ((year % 4) != 0) { return false; }
-            if ((year % 100) != 0) { return true; }
-            return ((year % 400) == 0);
-        };
-        for (int yy = 1970; yy < years; ++yy) {
-            seconds += (isLeapYear(yy) ? 366 : 365) * 86400;
-        }
-        static const int daysPerMonth[] = {
-            31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
-        };
-        for (int mm = 1; mm < months; ++mm) {
-            seconds += daysPerMonth[mm - 1] * 86400;
-            if (
-                (mm == 2)
-                && isLeapYear(years)
-            ) {
-                seconds += 86400;
-            }
-        }
-        seconds += (days - 1) * 86400;
-        seconds += hours * 3600;
-        seconds += minutes * 60;
+        int64_t seconds;
+        int milliseconds;
+        (void)ParseTimestamp(timestamp.data(), timestamp.length(), seconds, milliseconds);
         return (
             (double)seconds
             + (double)milliseconds / 1000.0
         );
     }
 
+    /**
+     * Convert the given time in UTC to the equivalent number of
+     * milliseconds since the UNIX epoch (Midnight UTC January 1, 1970).
+     *
+     * @param[in] timestamp
+     *     This is the timestamp to convert.
+     *
+     * @return
+     *     The equivalent timestamp in milliseconds since the UNIX epoch
+     *     is returned.
+     */
+    int64_t ParseTimestampMilliseconds(const std::string& timestamp) {
+        int64_t seconds;
+        int milliseconds;
+        (void)ParseTimestamp(timestamp.data(), timestamp.length(), seconds, milliseconds);
+        return seconds * 1000 + milliseconds;
+    }
+
+    /**
+     * This class builds the JSON equivalent of an XML document from the
+     * events reported by an XmlParser.  The root element of the document
+     * becomes the JSON object, each element containing other elements
+     * becomes a JSON object, and each element containing only text
+     * becomes a JSON string.
+     */
+    class XmlToJsonHandler
+        : public Aws::XmlParser::Handler
+    {
+        // Public methods
+    public:
+        /**
+         * This constructor sets up the handler to build a JSON object.
+         *
+         * @param[in] arrayElements
+         *     This is the set of tags which should be interpreted as JSON
+         *     arrays rather than as strings or objects.
+         */
+        explicit XmlToJsonHandler(const std::set< std::string >& arrayElements)
+            : arrayElements_(arrayElements)
+        {
+        }
+
+        /**
+         * Return the JSON built from the document.
+         *
+         * @return
+         *     The JSON built from the document is returned.
+         */
+        Json::Value& GetJson() {
+            return json_;
+        }
+
+        // Aws::XmlParser::Handler
+    public:
+        virtual void StartElement(const char* name, size_t nameLength) override {
+            if (depth_++ == 0) {
+                return;
+            }
+            auto& parent = (
+                elements_.empty()
+                ? json_
+                : *elements_.back()
+            );
+            if (parent.GetType() != Json::Value::Type::Object) {
+                parent = Json::Object({});
+            }
+            const std::string key(name, nameLength);
+            if (arrayElements_.find(key) == arrayElements_.end()) {
+                elements_.push_back(&parent[key]);
+            } else {
+                auto& child = parent[key];
+                if (child.GetType() != Json::Value::Type::Array) {
+                    child = Json::Array({});
+                }
+                child.Add(Json::Value());
+                elements_.push_back(&child[child.GetSize() - 1]);
+            }
+            text_.clear();
+        }
+
+        virtual void Text(const char* text, size_t length) override {
+            text_.append(text, length);
+        }
+
+        virtual void EndElement(const char* name, size_t nameLength) override {
+            if (--depth_ == 0) {
+                return;
+            }
+            auto& element = *elements_.back();
+            if (
+                !text_.empty()
+                && (element.GetType() != Json::Value::Type::Object)
+            ) {
+                element = text_;
+            }
+            elements_.pop_back();
+            text_.clear();
+        }
+
+        // Private properties
+    private:
+        /**
+         * This is the set of tags which should be interpreted as JSON
+         * arrays rather than as strings or objects.
+         */
+        const std::set< std::string >& arrayElements_;
+
+        /**
+         * This is the JSON built from the document.
+         */
+        Json::Value json_ = Json::Object({});
+
+        /**
+         * These are the JSON values of the elements which have been
+         * started but not yet ended, not counting the root element.
+         */
+        std::vector< Json::Value* > elements_;
+
+        /**
+         * This is the number of elements which have been started but not
+         * yet ended.
+         */
+        size_t depth_ = 0;
+
+        /**
+         * This holds the text of the current element.
+         */
+        std::string text_;
+    };
+
     /**
      * Convert the given XML document into the equivalent JSON.
      *
@@ -140,300 +582,2998 @@ namespace {
         const std::string& xml,
         const std::set< std::string >& arrayElements
     ) {
-        auto json = Json::Object({});
-        enum class State {
-            Header,
-            Document,
-            TagBegin,
-            Tag,
-            TagBeginOrContent,
-            Content,
-            TagEnd,
-            End,
-        } state = State::Header;
-        std::string data;
-        std::stack< Json::Value* > elements;
-        for (auto c: xml) {
-            switch (state) {
-                case State::Header: {
-                    if (c == '>') {
-                        state = State::Document;
-                    }
-                } break;
-
-                case State::Document: {
-                    if (c == '>') {
-                        state = State::TagBegin;
-                    }
-                } break;
-
-                case State::TagBegin: {
-                    if (c == '<') {
-                        state = State::Tag;
-                        data.clear();
-                    }
-                } break;
-
-                case State::Tag: {
-                    if (c == '/') {
-                        state = State::TagEnd;
-                    } else if (c == '>') {
-                        state = State::TagBeginOrContent;
-                        auto& parent = (
-                            elements.empty()
-                            ? json
-                            : *elements.top()
-                        );
-                        if (parent.GetType() != Json::Value::Type::Object) {
-                            parent = Json::Object({});
-                        }
-                        if (arrayElements.find(data) == arrayElements.end()) {
-                            auto& child = parent[data];
-                            elements.push(&child);
-                        } else {
-                            if (parent[data].GetType() != Json::Value::Type::Array) {
-                                parent[data] = Json::Array({});
-                            }
-                            auto& child = parent[data];
-                            child.Add(Json::Value());
-                            auto& element = child[child.GetSize() - 1];
-                            elements.push(&element);
-                        }
-                        data.clear();
-                    } else {
-                        data += c;
-                    }
-                } break;
-
-                case State::TagBeginOrContent: {
-                    if (c == '<') {
-                        state = State::Tag;
-                    } else {
-                        state = State::Content;
-                        data += c;
-                    }
-                } break;
-
-                case State::Content: {
-                    if (c == '<') {
-                        auto& parent = (
-                            elements.empty()
-                            ? json
-                            : *elements.top()
-                        );
-                        parent = data;
-                        state = State::TagEnd;
-                    } else {
-                        data += c;
-                    }
-                } break;
-
-                case State::TagEnd: {
-                    if (c == '>') {
-                        if (elements.empty()) {
-                            state = State::End;
-                        } else {
-                            elements.pop();
-                            state = State::TagBegin;
-                        }
-                    }
-                } break;
+        ParsingTimer parsingTimer;
+        XmlToJsonHandler handler(arrayElements);
+        Aws::XmlParser parser(handler);
+        (void)parser.Parse(xml);
+        return std::move(handler.GetJson());
+    }
 
-                default: break;
+    /**
+     * Parse the given decimal number.
+     *
+     * @param[in] text
+     *     This is the number to parse.
+     *
+     * @return
+     *     The value of the number is returned.  Parsing stops at the first
+     *     character which isn't a decimal digit.
+     */
+    uint64_t ParseDecimal(const std::string& text) {
+        uint64_t value = 0;
+        for (const auto c: text) {
+            if ((c < '0') || (c > '9')) {
+                break;
             }
+            value = value * 10 + (uint64_t)(c - '0');
         }
-        return json;
+        return value;
     }
 
-}
-
-namespace Aws {
-
     /**
-     * This contains the private properties of an S3 instance.
+     * This is the base class for classes which decode a page of results
+     * from the S3 ListObjects API directly from the events reported by an
+     * XmlParser.  It gathers up the information about each object, and
+     * hands it to the derived class to store once it's complete.
      */
-    struct S3::Impl {
+    class ListObjectsPageHandler
+        : public Aws::XmlParser::Handler
+    {
+        // Public methods
+    public:
         /**
-         * This is the HTTP client to use to communicate with Amazon S3.
+         * Return an indication of whether or not the page says there are
+         * more pages after it.
+         *
+         * @return
+         *     An indication of whether or not there are more pages after
+         *     this one is returned.
          */
-        std::shared_ptr< Http::IClient > http;
+        bool IsTruncated() const {
+            return (
+                isTruncated_
+                && !nextContinuationToken_.empty()
+            );
+        }
 
         /**
-         * This is the Amazon Web Services (AWS) configuration to use.
+         * Return the token which identifies the page after this one.
+         *
+         * @return
+         *     The token which identifies the page after this one is
+         *     returned.
          */
-        Config config;
-    };
-
-    S3::~S3() noexcept = default;
-    S3::S3(S3&& other) noexcept = default;
-    S3& S3::operator=(S3&& other) noexcept = default;
+        std::string& GetNextContinuationToken() {
+            return nextContinuationToken_;
+        }
 
-    S3::S3()
-        : impl_(new Impl)
-    {
-    }
+        // Aws::XmlParser::Handler
+    public:
+        virtual void StartElement(const char* name, size_t nameLength) override {
+            ++depth_;
+            text_.clear();
+            if (depth_ == 2) {
+                if (IsNamed(name, nameLength, "Contents")) {
+                    container_ = Container::Contents;
+                    key_.clear();
+                    eTag_.clear();
+                    lastModified_.clear();
+                    size_.clear();
+                } else if (IsNamed(name, nameLength, "CommonPrefixes")) {
+                    container_ = Container::CommonPrefixes;
+                }
+            }
+        }
 
-    void S3::Configure(
-        std::shared_ptr< Http::IClient > http,
-        Config config
-    ) {
-        impl_->http = http;
-        impl_->config = config;
-    }
+        virtual void Text(const char* text, size_t length) override {
+            text_.append(text, length);
+        }
 
-    auto S3::ListBuckets() -> std::future< ListBucketsResult > {
-        auto impl(impl_);
-        return std::async(
-            std::launch::async,
-            [impl]{
-                ListBucketsResult result;
-                const auto host = "s3." + impl->config.region + ".amazonaws.com";
-                const auto date = AmzTimestamp(time(NULL));
-                Http::Request request;
-                request.method = "GET";
-                request.target.SetHost(host);
-                request.target.SetPort(443);
-                request.target.SetPath({""});
-                request.headers.AddHeader("Host", host);
-                request.headers.AddHeader("x-amz-date", date);
-                const auto canonicalRequest = SignApi::ConstructCanonicalRequest(request.Generate());
-                const auto payloadHashOffset = canonicalRequest.find_last_of('\n') + 1;
-                const auto payloadHash = canonicalRequest.substr(payloadHashOffset);
-                const auto stringToSign = SignApi::MakeStringToSign(
-                    impl->config.region,
-                    "s3",
-                    canonicalRequest
-                );
-                const auto authorization = SignApi::MakeAuthorization(
-                    stringToSign,
-                    canonicalRequest,
-                    impl->config.accessKeyId,
-                    impl->config.secretAccessKey
-                );
-                request.headers.AddHeader("Authorization", authorization);
-                request.headers.AddHeader("x-amz-content-sha256", payloadHash);
-                if (!impl->config.sessionToken.empty()) {
-                    request.headers.AddHeader("x-amz-security-token", impl->config.sessionToken);
-                }
-                const auto rawRequest = request.Generate();
-                const auto transaction = impl->http->Request(request);
-                transaction->AwaitCompletion();
-                result.transactionState = transaction->state;
-                result.statusCode = transaction->response.statusCode;
-                if (transaction->state == Http::IClient::Transaction::State::Completed) {
-                    if (transaction->response.statusCode == 200) {
-                        const auto parsedBody = XmlToJson(
-                            transaction->response.body,
-                            std::set< std::string >({"Bucket"})
-                        );
-                        result.owner.id = (std::string)parsedBody["Owner"]["ID"];
-                        result.owner.displayName = (std::string)parsedBody["Owner"]["DisplayName"];
-                        const auto& buckets = parsedBody["Buckets"]["Bucket"];
-                        const auto numBuckets = buckets.GetSize();
-                        for (size_t i = 0; i < numBuckets; ++i) {
-                            const auto& bucketJson = buckets[i];
-                            Bucket bucket;
-                            bucket.name = (std::string)bucketJson["Name"];
-                            bucket.creationDate = ParseTimestamp(bucketJson["CreationDate"]);
-                            result.buckets.push_back(std::move(bucket));
-                        }
-                    } else {
-                        result.errorInfo = XmlToJson(
-                            transaction->response.body,
-                            std::set< std::string >({})
-                        );
+        virtual void EndElement(const char* name, size_t nameLength) override {
+            if (depth_ == 2) {
+                if (container_ == Container::Contents) {
+                    AddObject(key_, eTag_, lastModified_, size_);
+                }
+                container_ = Container::None;
+                if (IsNamed(name, nameLength, "IsTruncated")) {
+                    isTruncated_ = (text_ == "true");
+                } else if (IsNamed(name, nameLength, "NextContinuationToken")) {
+                    nextContinuationToken_ = text_;
+                }
+            } else if (depth_ == 3) {
+                if (container_ == Container::Contents) {
+                    if (IsNamed(name, nameLength, "Key")) {
+                        key_.swap(text_);
+                    } else if (IsNamed(name, nameLength, "LastModified")) {
+                        lastModified_.swap(text_);
+                    } else if (IsNamed(name, nameLength, "ETag")) {
+                        eTag_.swap(text_);
+                    } else if (IsNamed(name, nameLength, "Size")) {
+                        size_.swap(text_);
+                    }
+                } else if (container_ == Container::CommonPrefixes) {
+                    if (IsNamed(name, nameLength, "Prefix")) {
+                        AddCommonPrefix(text_);
                     }
                 }
-                return result;
             }
-        );
-    }
+            text_.clear();
+            --depth_;
+        }
 
-    auto S3::ListObjects(const std::string& bucketName) -> std::future< ListObjectsResult > {
-        auto impl(impl_);
-        return std::async(
-            std::launch::async,
-            [impl, bucketName]{
-                ListObjectsResult result;
-                const auto host = "s3." + impl->config.region + ".amazonaws.com";
-                const auto date = AmzTimestamp(time(NULL));
-                std::string continuationToken;
-                do {
-                    Http::Request request;
-                    request.method = "GET";
-                    request.target.SetHost(host);
-                    request.target.SetPort(443);
-                    request.target.SetPath({"", bucketName});
-                    std::vector< std::string > queryParts = {"list-type=2"};
-                    if (!continuationToken.empty()) {
-                        queryParts.push_back("continuation-token=" + continuationToken);
-                    }
-                    request.target.SetQuery(StringExtensions::Join(queryParts, "&"));
-                    request.headers.AddHeader("Host", host);
-                    request.headers.AddHeader("x-amz-date", date);
-                    const auto canonicalRequest = SignApi::ConstructCanonicalRequest(request.Generate());
-                    const auto payloadHashOffset = canonicalRequest.find_last_of('\n') + 1;
-                    const auto payloadHash = canonicalRequest.substr(payloadHashOffset);
-                    const auto stringToSign = SignApi::MakeStringToSign(
-                        impl->config.region,
-                        "s3",
-                        canonicalRequest
-                    );
-                    const auto authorization = SignApi::MakeAuthorization(
-                        stringToSign,
-                        canonicalRequest,
-                        impl->config.accessKeyId,
-                        impl->config.secretAccessKey
-                    );
-                    request.headers.AddHeader("Authorization", authorization);
-                    request.headers.AddHeader("x-amz-content-sha256", payloadHash);
-                    if (!impl->config.sessionToken.empty()) {
-                        request.headers.AddHeader("x-amz-security-token", impl->config.sessionToken);
-                    }
-                    const auto rawRequest = request.Generate();
-                    const auto transaction = impl->http->Request(request);
-                    transaction->AwaitCompletion();
-                    result.transactionState = transaction->state;
-                    result.statusCode = transaction->response.statusCode;
-                    if (transaction->state == Http::IClient::Transaction::State::Completed) {
-                        if (transaction->response.statusCode == 200) {
-                            const auto parsedBody = XmlToJson(
-                                transaction->response.body,
-                                std::set< std::string >({"Contents"})
-                            );
-                            const auto& parsedObjects = parsedBody["Contents"];
-                            const auto numObjects = parsedObjects.GetSize();
-                            for (size_t i = 0; i < numObjects; ++i) {
-                                const auto& parsedObject = parsedObjects[i];
-                                Object object;
-                                object.key = (std::string)parsedObject["Key"];
-                                object.lastModified = ParseTimestamp(parsedObject["LastModified"]);
-                                object.eTag = (std::string)parsedObject["ETag"];
-                                object.eTag = object.eTag.substr(6, object.eTag.size() - 12);
-                                (void)sscanf(
-                                    ((std::string)parsedObject["Size"]).c_str(),
-                                    "%zu",
-                                    &object.size
-                                );
-                                result.objects.push_back(std::move(object));
+        // Protected methods
+    protected:
+        /**
+         * Store the information about an object in the page.
+         *
+         * @param[in] key
+         *     This is the key of the object.
+         *
+         * @param[in] eTag
+         *     This is the entity tag of the object, in quotation marks.
+         *
+         * @param[in] lastModified
+         *     This is the time when the object was last modified, in
+         *     ISO 8601 format.
+         *
+         * @param[in] size
+         *     This is the size of the object in bytes, in decimal.
+         */
+        virtual void AddObject(
+            std::string& key,
+            std::string& eTag,
+            const std::string& lastModified,
+            const std::string& size
+        ) = 0;
+
+        /**
+         * Store a common prefix in the page.
+         *
+         * @param[in] commonPrefix
+         *     This is the common prefix.
+         */
+        virtual void AddCommonPrefix(std::string& commonPrefix) = 0;
+
+        // Private methods
+    private:
+        /**
+         * Determine whether or not the given name is the given string.
+         *
+         * @param[in] name
+         *     This points to the name to check.
+         *
+         * @param[in] nameLength
+         *     This is the number of characters in the name.
+         *
+         * @param[in] target
+         *     This is the string to compare with the name.
+         *
+         * @return
+         *     An indication of whether or not the name is the given
+         *     string is returned.
+         */
+        static bool IsNamed(const char* name, size_t nameLength, const char* target) {
+            return (
+                (strlen(target) == nameLength)
+                && (memcmp(name, target, nameLength) == 0)
+            );
+        }
+
+        // Private properties
+    private:
+        /**
+         * These are the kinds of elements in the page which contain other
+         * elements of interest.
+         */
+        enum class Container {
+            None,
+            Contents,
+            CommonPrefixes,
+        };
+
+        /**
+         * This is the number of elements which have been started but not
+         * yet ended.
+         */
+        size_t depth_ = 0;
+
+        /**
+         * This is the kind of element, if any, at the second level of the
+         * document which contains the current element.
+         */
+        Container container_ = Container::None;
+
+        /**
+         * This indicates whether or not the page says there are more
+         * pages after it.
+         */
+        bool isTruncated_ = false;
+
+        /**
+         * This identifies the page after this one, if any.
+         */
+        std::string nextContinuationToken_;
+
+        /**
+         * This holds the text of the current element.
+         */
+        std::string text_;
+
+        /**
+         * This holds the key of the current object.
+         */
+        std::string key_;
+
+        /**
+         * This holds the entity tag of the current object.
+         */
+        std::string eTag_;
+
+        /**
+         * This holds the time when the current object was last modified.
+         */
+        std::string lastModified_;
+
+        /**
+         * This holds the size of the current object.
+         */
+        std::string size_;
+    };
+
+    /**
+     * This class decodes a page of results from the S3 ListObjects API
+     * into a separate structure for each object.
+     */
+    class ObjectsPageHandler
+        : public ListObjectsPageHandler
+    {
+        // Public methods
+    public:
+        /**
+         * This constructor sets up the handler to decode a page of results.
+         *
+         * @param[in,out] result
+         *     This is where to store the decoded results.
+         */
+        explicit ObjectsPageHandler(Aws::S3::ListObjectsPageResult& result)
+            : result_(result)
+        {
+        }
+
+        /**
+         * Complete the decoded results, once the whole page has been
+         * parsed.
+         */
+        void Finish() {
+            result_.isTruncated = IsTruncated();
+            result_.nextContinuationToken = std::move(GetNextContinuationToken());
+        }
+
+        // ListObjectsPageHandler
+    protected:
+        virtual void AddObject(
+            std::string& key,
+            std::string& eTag,
+            const std::string& lastModified,
+            const std::string& size
+        ) override {
+            Aws::S3::Object object;
+            object.key = std::move(key);
+            if (
+                (eTag.length() >= 2)
+                && (eTag.front() == '"')
+                && (eTag.back() == '"')
+            ) {
+                object.eTag.assign(eTag, 1, eTag.length() - 2);
+            } else {
+                object.eTag = std::move(eTag);
+            }
+            object.lastModified = ParseTimestamp(lastModified);
+            object.size = (size_t)ParseDecimal(size);
+            result_.objects.push_back(std::move(object));
+        }
+
+        virtual void AddCommonPrefix(std::string& commonPrefix) override {
+            result_.commonPrefixes.push_back(std::move(commonPrefix));
+        }
+
+        // Private properties
+    private:
+        /**
+         * This is where to store the decoded results.
+         */
+        Aws::S3::ListObjectsPageResult& result_;
+    };
+
+    /**
+     * This class decodes a page of results from the S3 ListObjects API
+     * into a compact list of objects.
+     */
+    class CompactObjectsPageHandler
+        : public ListObjectsPageHandler
+    {
+        // Public methods
+    public:
+        /**
+         * This constructor sets up the handler to decode a page of results.
+         *
+         * @param[in,out] result
+         *     This is where to add the decoded results.
+         */
+        explicit CompactObjectsPageHandler(Aws::S3::CompactListObjectsResult& result)
+            : result_(result)
+        {
+        }
+
+        // ListObjectsPageHandler
+    protected:
+        virtual void AddObject(
+            std::string& key,
+            std::string& eTag,
+            const std::string& lastModified,
+            const std::string& size
+        ) override {
+            result_.objects.Add(
+                key.data(),
+                key.length(),
+                eTag.data(),
+                eTag.length(),
+                ParseTimestampMilliseconds(lastModified),
+                ParseDecimal(size)
+            );
+        }
+
+        virtual void AddCommonPrefix(std::string& commonPrefix) override {
+            result_.commonPrefixes.push_back(std::move(commonPrefix));
+        }
+
+        // Private properties
+    private:
+        /**
+         * This is where to add the decoded results.
+         */
+        Aws::S3::CompactListObjectsResult& result_;
+    };
+
+}
+
+namespace Aws {
+
+    /**
+     * This contains the private properties of an S3 instance.
+     */
+    struct S3::Impl
+        : public std::enable_shared_from_this< S3::Impl >
+    {
+        /**
+         * This is the HTTP client to use to communicate with Amazon S3.
+         */
+        std::shared_ptr< Http::IClient > http;
+
+        /**
+         * This is the Amazon Web Services (AWS) configuration to use.
+         */
+        Config config;
+
+        /**
+         * This remembers the keys derived to sign requests, so that they
+         * don't have to be derived again for every request.
+         */
+        SigningKeyCache signingKeyCache;
+
+        /**
+         * This is used to carry out requests without starting a new
+         * thread for each one.
+         */
+        std::shared_ptr< WorkerPool > workerPool;
+
+        /**
+         * This provides the current time, formatted as needed for the
+         * "x-amz-date" header of each request.
+         */
+        std::shared_ptr< TimestampProvider > timestampProvider;
+
+        /**
+         * If not null, this is the object to notify about each request
+         * made of S3, once it's complete.
+         */
+        std::shared_ptr< MetricsObserver > metricsObserver;
+
+        // Types
+
+        /**
+         * This holds the state of a download of an object in parts.
+         */
+        struct Download {
+            /**
+             * This is used to synchronize access to the state.
+             */
+            std::mutex mutex;
+
+            /**
+             * This is the name of the bucket containing the object.
+             */
+            std::string bucketName;
+
+            /**
+             * This is the name of the object to retrieve.
+             */
+            std::string objectName;
+
+            /**
+             * This is the function to call to write each part.
+             */
+            ContentWriter contentWriter;
+
+            /**
+             * This is the number of bytes to request in each part.
+             */
+            size_t partSize = 0;
+
+            /**
+             * This is the maximum number of parts to request at once.
+             */
+            size_t maxPartsInFlight = 0;
+
+            /**
+             * This is the entity tag of the object, as reported in the
+             * response for the first part.  It's used to make sure every
+             * part comes from the same version of the object.
+             */
+            std::string eTag;
+
+            /**
+             * This is the size of the object, once it's known.
+             */
+            size_t totalSize = 0;
+
+            /**
+             * This is the offset of the next part to request.
+             */
+            size_t nextOffset = 0;
+
+            /**
+             * This is the number of parts requested but not yet received.
+             */
+            size_t partsInFlight = 0;
+
+            /**
+             * This indicates whether or not any part failed.
+             */
+            bool failed = false;
+
+            /**
+             * This is where the results of the download are collected.
+             */
+            GetObjectResult result;
+
+            /**
+             * This is the function to call with the results, once the
+             * download is complete.
+             */
+            GetObjectDelegate onCompletion;
+        };
+
+        /**
+         * This holds the state of an upload of an object in parts.
+         */
+        struct Upload {
+            /**
+             * This is used to synchronize access to the state.
+             */
+            std::mutex mutex;
+
+            /**
+             * This is the name of the bucket in which to store the object.
+             */
+            std::string bucketName;
+
+            /**
+             * This is the name of the object to store.
+             */
+            std::string objectName;
+
+            /**
+             * This is the function to call to read the object contents.
+             */
+            ContentSource contentSource;
+
+            /**
+             * This is the number of bytes to upload in each part.
+             */
+            size_t partSize = 0;
+
+            /**
+             * This is the maximum number of parts to upload at once.
+             */
+            size_t maxPartsInFlight = 0;
+
+            /**
+             * This is the maximum number of times to try uploading
+             * each part.
+             */
+            size_t maxAttemptsPerPart = 0;
+
+            /**
+             * This identifies the multipart upload to S3.
+             */
+            std::string uploadId;
+
+            /**
+             * This is the number of the next part to read.
+             */
+            unsigned int nextPartNumber = 1;
+
+            /**
+             * This is the number of parts read but not yet uploaded.
+             */
+            size_t partsInFlight = 0;
+
+            /**
+             * This indicates whether or not a part is being read from the
+             * content source.
+             */
+            bool reading = false;
+
+            /**
+             * This indicates whether or not the end of the contents has
+             * been reached.
+             */
+            bool sourceExhausted = false;
+
+            /**
+             * This indicates whether or not any part failed to upload.
+             */
+            bool failed = false;
+
+            /**
+             * This indicates whether or not the upload is being completed
+             * or aborted.
+             */
+            bool finishing = false;
+
+            /**
+             * These are the parts uploaded so far.
+             */
+            std::vector< CompletedPart > completedParts;
+
+            /**
+             * If a part fails to upload, the results of the last attempt
+             * to upload it are stored here.
+             */
+            CompleteMultipartUploadResult result;
+
+            /**
+             * This is the function to call with the results, once the
+             * upload is complete.
+             */
+            CompleteMultipartUploadDelegate onCompletion;
+        };
+
+        /**
+         * This holds the state of a listing of the objects in a bucket,
+         * where the keys are divided into partitions which are listed
+         * at the same time.
+         */
+        struct Listing {
+            /**
+             * This is used to synchronize access to the state.
+             */
+            std::mutex mutex;
+
+            /**
+             * This is the name of the bucket whose objects are listed.
+             */
+            std::string bucketName;
+
+            /**
+             * These select which objects to list, and how.
+             */
+            ListObjectsOptions options;
+
+            /**
+             * These are the keys which divide the partitions, in order.
+             * Each key is the last one which can be in the partition
+             * before it.
+             */
+            std::vector< std::string > splitPoints;
+
+            /**
+             * This is the maximum number of partitions to list at once.
+             */
+            size_t maxPartitionsInFlight = 0;
+
+            /**
+             * This is the index of the next partition to start listing.
+             */
+            size_t nextPartition = 0;
+
+            /**
+             * This is the number of partitions being listed.
+             */
+            size_t partitionsInFlight = 0;
+
+            /**
+             * This indicates whether or not the listing of any partition
+             * has failed.
+             */
+            bool failed = false;
+
+            /**
+             * This indicates whether or not all partitions have been
+             * listed and the results are being reported.
+             */
+            bool finishing = false;
+
+            /**
+             * These are the results of listing each partition.
+             */
+            std::vector< ListObjectsResult > partitions;
+
+            /**
+             * This is the function to call with the results, once all
+             * the partitions have been listed.
+             */
+            ListObjectsDelegate onCompletion;
+        };
+
+        // Methods
+
+        /**
+         * Sign the given request and add the headers needed by Amazon S3
+         * to authenticate it.
+         *
+         * @param[in,out] request
+         *     This is the request to sign.
+         *
+         * @return
+         *     The results of signing the request are returned.  They
+         *     remain valid until the next request is signed on the same
+         *     thread.
+         */
+        const SignApi::RequestSignature& SignRequest(Http::Request& request) {
+            thread_local SignApi::RequestSignature signature;
+            const bool measuring = (metricsObserver != nullptr);
+            std::chrono::steady_clock::time_point start, canonicalized;
+            if (measuring) {
+                start = std::chrono::steady_clock::now();
+            }
+            SignApi::ConstructCanonicalRequest(request, signature.canonicalRequest);
+            if (measuring) {
+                canonicalized = std::chrono::steady_clock::now();
+            }
+            SignApi::SignCanonicalRequest(
+                config.region,
+                "s3",
+                config.accessKeyId,
+                config.secretAccessKey,
+                signingKeyCache,
+                signature
+            );
+            request.headers.AddHeader("Authorization", signature.authorization);
+            if (!request.headers.HasHeader("x-amz-content-sha256")) {
+                request.headers.AddHeader("x-amz-content-sha256", signature.canonicalRequest.payloadHash);
+            }
+            if (!config.sessionToken.empty()) {
+                request.headers.AddHeader("x-amz-security-token", config.sessionToken);
+            }
+            if (measuring) {
+                metricsOfRequestBeingMade.timings.canonicalization = canonicalized - start;
+                metricsOfRequestBeingMade.timings.signing = std::chrono::steady_clock::now() - canonicalized;
+            }
+            return signature;
+        }
+
+        /**
+         * Append the given chunk of a payload, signed and encoded as
+         * required by the "aws-chunked" content encoding, to the given
+         * request body.
+         *
+         * @param[in,out] body
+         *     This is the request body to which to append the chunk.
+         *
+         * @param[in] data
+         *     This points to the data of the chunk.
+         *
+         * @param[in] length
+         *     This is the number of bytes of data in the chunk.
+         *
+         * @param[in] signature
+         *     This holds the results of signing the request.
+         *
+         * @param[in,out] previousSignature
+         *     This is the signature of the previous chunk, or the seed
+         *     signature of the request, for the first chunk.  It's
+         *     updated to be the signature of this chunk.
+         */
+        void AppendSignedChunk(
+            std::string& body,
+            const char* data,
+            size_t length,
+            const SignApi::RequestSignature& signature,
+            std::string& previousSignature
+        ) {
+            IncrementalSha256 chunkHash;
+            chunkHash.Append(data, length);
+            previousSignature = SignApi::MakeChunkSignature(
+                signature,
+                previousSignature,
+                chunkHash.FinishAsHex(),
+                config.secretAccessKey,
+                signingKeyCache
+            );
+            body += StringExtensions::sprintf("%zx", length);
+            body += CHUNK_SIGNATURE_PREFIX;
+            body += previousSignature;
+            body += "\r\n";
+            body.append(data, length);
+            body += "\r\n";
+        }
+
+        /**
+         * Start building a request to make of Amazon S3, with the headers
+         * that every request needs, other than those used to sign it.
+         *
+         * @param[in] method
+         *     This is the HTTP method of the request.
+         *
+         * @param[in] path
+         *     These are the segments of the path of the request target.
+         *
+         * @return
+         *     The new request is returned.
+         */
+        Http::Request MakeRequest(
+            const std::string& method,
+            const std::vector< std::string >& path
+        ) {
+            const auto host = "s3." + config.region + ".amazonaws.com";
+            Http::Request request;
+            request.method = method;
+            request.target.SetHost(host);
+            request.target.SetPort(443);
+            request.target.SetPath(path);
+            request.headers.AddHeader("Host", host);
+            request.headers.AddHeader("x-amz-date", timestampProvider->GetTimestamp());
+            if (metricsObserver != nullptr) {
+                metricsOfRequestBeingMade = RequestMetrics();
+                metricsOfRequestBeingMade.bucketName = ((path.size() > 1) ? path[1] : "");
+                metricsOfRequestBeingMade.method = method;
+                metricsOfRequestBeingMade.retries = retriesOfNextRequest;
+                metricsOfRequestBeingMade.timings.queueWait = queueWaitOfTask;
+                startOfRequestBeingMade = std::chrono::steady_clock::now() - queueWaitOfTask;
+            }
+            retriesOfNextRequest = 0;
+            queueWaitOfTask = std::chrono::nanoseconds::zero();
+            return request;
+        }
+
+        /**
+         * Start building a request to make of Amazon S3 about the given
+         * object, with the headers that every request needs, other than
+         * those used to sign it.
+         *
+         * @param[in] method
+         *     This is the HTTP method of the request.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object.
+         *
+         * @return
+         *     The new request is returned.
+         */
+        Http::Request MakeObjectRequest(
+            const std::string& method,
+            const std::string& bucketName,
+            const std::string& objectName
+        ) {
+            auto path = Split(objectName, '/');
+            path.insert(path.begin(), {"", bucketName});
+            return MakeRequest(method, path);
+        }
+
+        /**
+         * Post the given task to the worker pool, arranging for the time
+         * it waits there to be accounted to the first request it makes.
+         *
+         * @param[in] task
+         *     This is the task to post.
+         *
+         * @param[in] delay
+         *     This is how long to wait before the task may be run.  This
+         *     time isn't counted as waiting in the worker pool.
+         */
+        void Post(
+            std::function< void() > task,
+            std::chrono::milliseconds delay = std::chrono::milliseconds::zero()
+        ) {
+            const auto posted = std::chrono::steady_clock::now() + delay;
+            auto wrappedTask = [posted, task]{
+                queueWaitOfTask = std::chrono::steady_clock::now() - posted;
+                task();
+                queueWaitOfTask = std::chrono::nanoseconds::zero();
+            };
+            if (delay > std::chrono::milliseconds::zero()) {
+                workerPool->PostDelayed(std::move(wrappedTask), delay);
+            } else {
+                workerPool->Post(std::move(wrappedTask));
+            }
+        }
+
+        /**
+         * Send the given request, arranging for the given delegate to be
+         * called once the transaction is complete.  No thread waits for
+         * the transaction to complete.
+         *
+         * @param[in] operation
+         *     This is the kind of request being made.
+         *
+         * @param[in] request
+         *     This is the request to send.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call once the transaction is
+         *     complete.
+         */
+        void IssueRequest(
+            Operation operation,
+            Http::Request&& request,
+            std::function< void(const Http::IClient::Transaction& transaction) > onCompletion
+        ) {
+            // Without an observer, none of the information about the
+            // request is collected.
+            const auto metricsObserver = this->metricsObserver;
+            if (metricsObserver == nullptr) {
+                const auto transaction = http->Request(std::move(request));
+
+                // The completion delegate holds the transaction only until
+                // it's called, to avoid a reference cycle between the two.
+                const auto transactionHolder = std::make_shared< std::shared_ptr< Http::IClient::Transaction > >(
+                    transaction
+                );
+                transaction->SetCompletionDelegate(
+                    [transactionHolder, onCompletion]{
+                        std::shared_ptr< Http::IClient::Transaction > transaction;
+                        transaction.swap(*transactionHolder);
+                        if (transaction == nullptr) {
+                            return;
+                        }
+                        onCompletion(*transaction);
+                    }
+                );
+                return;
+            }
+            auto metrics = std::move(metricsOfRequestBeingMade);
+            metricsOfRequestBeingMade = RequestMetrics();
+            metrics.operation = operation;
+            metrics.bytesSent = request.body.size();
+            const auto start = startOfRequestBeingMade;
+            const auto sent = std::chrono::steady_clock::now();
+            const auto transaction = http->Request(std::move(request));
+
+            // The completion delegate holds the transaction only until it's
+            // called, to avoid a reference cycle between the two.
+            const auto transactionHolder = std::make_shared< std::shared_ptr< Http::IClient::Transaction > >(
+                transaction
+            );
+            transaction->SetCompletionDelegate(
+                [
+                    transactionHolder,
+                    onCompletion,
+                    metrics,
+                    metricsObserver,
+                    start,
+                    sent
+                ]() mutable {
+                    std::shared_ptr< Http::IClient::Transaction > transaction;
+                    transaction.swap(*transactionHolder);
+                    if (transaction == nullptr) {
+                        return;
+                    }
+
+                    // The delegate is called only once, so the metrics
+                    // it holds are completed in place.
+                    metrics.timings.transaction = std::chrono::steady_clock::now() - sent;
+                    metrics.transactionState = transaction->state;
+                    metrics.statusCode = transaction->response.statusCode;
+                    metrics.bytesReceived = transaction->response.body.size();
+
+                    // Handling the response may involve handling the
+                    // responses to other requests on this same thread,
+                    // so set aside any time already spent parsing.
+                    const auto timeSpentParsingBefore = timeSpentParsing;
+                    timeSpentParsing = std::chrono::nanoseconds::zero();
+                    onCompletion(*transaction);
+                    metrics.timings.parsing = timeSpentParsing;
+                    timeSpentParsing = timeSpentParsingBefore;
+                    metrics.duration = std::chrono::steady_clock::now() - start;
+                    metricsObserver->RequestCompleted(metrics);
+                }
+            );
+        }
+
+        /**
+         * List the S3 buckets owned by the configured user.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void ListBuckets(ListBucketsDelegate onCompletion) {
+            auto request = MakeRequest("GET", {""});
+            SignRequest(request);
+            IssueRequest(
+                Operation::ListBuckets,
+                std::move(request),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    ListBucketsResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        if (transaction.response.statusCode == 200) {
+                            const auto parsedBody = XmlToJson(
+                                transaction.response.body,
+                                std::set< std::string >({"Bucket"})
+                            );
+                            result.owner.id = (std::string)parsedBody["Owner"]["ID"];
+                            result.owner.displayName = (std::string)parsedBody["Owner"]["DisplayName"];
+                            const auto& buckets = parsedBody["Buckets"]["Bucket"];
+                            const auto numBuckets = buckets.GetSize();
+                            for (size_t i = 0; i < numBuckets; ++i) {
+                                const auto& bucketJson = buckets[i];
+                                Bucket bucket;
+                                bucket.name = (std::string)bucketJson["Name"];
+                                bucket.creationDate = ParseTimestamp(bucketJson["CreationDate"]);
+                                result.buckets.push_back(std::move(bucket));
                             }
-                            if ((std::string)parsedBody["IsTruncated"] == "true") {
-                                continuationToken = (std::string)parsedBody["NextContinuationToken"];
-                            } else {
-                                continuationToken.clear();
+                        } else {
+                            result.errorInfo = XmlToJson(
+                                transaction.response.body,
+                                std::set< std::string >({})
+                            );
+                        }
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * Construct and sign a request for one page of the list of the
+         * objects in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket for which to list objects.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page of results to request, or is
+         *     empty to request the first page.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @return
+         *     The request is returned.
+         */
+        Http::Request MakeListObjectsRequest(
+            const std::string& bucketName,
+            const std::string& continuationToken,
+            const ListObjectsOptions& options
+        ) {
+            // Keys, prefixes and continuation tokens may contain any
+            // character, including "&", "+" and "=", so every value is
+            // percent-encoded.
+            auto request = MakeRequest("GET", {"", bucketName});
+            std::vector< std::string > queryParts = {"list-type=2"};
+            if (!continuationToken.empty()) {
+                queryParts.push_back("continuation-token=" + SignApi::AmzUriEncode(continuationToken));
+            }
+            if (!options.delimiter.empty()) {
+                queryParts.push_back("delimiter=" + SignApi::AmzUriEncode(options.delimiter));
+            }
+            if (options.maxKeys != 0) {
+                queryParts.push_back(StringExtensions::sprintf("max-keys=%zu", options.maxKeys));
+            }
+            if (!options.prefix.empty()) {
+                queryParts.push_back("prefix=" + SignApi::AmzUriEncode(options.prefix));
+            }
+            if (!options.startAfter.empty()) {
+                queryParts.push_back("start-after=" + SignApi::AmzUriEncode(options.startAfter));
+            }
+            request.target.SetQuery(StringExtensions::Join(queryParts, "&"));
+            SignRequest(request);
+            return request;
+        }
+
+        /**
+         * List one page of the objects in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket for which to list objects.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page of results to request, or is
+         *     empty to request the first page.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results, once the
+         *     page has been received.
+         */
+        void ListObjectsPage(
+            const std::string& bucketName,
+            const std::string& continuationToken,
+            const ListObjectsOptions& options,
+            ListObjectsPageDelegate onCompletion
+        ) {
+            auto request = MakeListObjectsRequest(bucketName, continuationToken, options);
+            IssueRequest(
+                Operation::ListObjects,
+                std::move(request),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    ListObjectsPageResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    if (transaction.state != Http::IClient::Transaction::State::Completed) {
+                        onCompletion(std::move(result));
+                        return;
+                    }
+                    if (transaction.response.statusCode != 200) {
+                        result.errorInfo = XmlToJson(
+                            transaction.response.body,
+                            std::set< std::string >({})
+                        );
+                        onCompletion(std::move(result));
+                        return;
+                    }
+                    {
+                        ParsingTimer parsingTimer;
+                        ObjectsPageHandler handler(result);
+                        XmlParser parser(handler);
+                        const auto wellFormed = parser.Parse(transaction.response.body);
+                        handler.Finish();
+                        if (!wellFormed) {
+                            result.transactionState = Http::IClient::Transaction::State::Broken;
+                            result.isTruncated = false;
+                        }
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * List the objects in the given S3 bucket, starting with the page
+         * of results identified by the given continuation token, and
+         * continuing with the remaining pages.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket for which to list objects.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page of results to request, or is
+         *     empty to request the first page.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] result
+         *     This is where the results from all the pages are collected.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results, once the
+         *     last page has been received.
+         */
+        void ListObjects(
+            const std::string& bucketName,
+            const std::string& continuationToken,
+            const ListObjectsOptions& options,
+            std::shared_ptr< ListObjectsResult > result,
+            ListObjectsDelegate onCompletion
+        ) {
+            const auto self = shared_from_this();
+            ListObjectsPage(
+                bucketName,
+                continuationToken,
+                options,
+                [self, bucketName, options, result, onCompletion](ListObjectsPageResult page){
+                    result->transactionState = page.transactionState;
+                    result->statusCode = page.statusCode;
+                    result->errorInfo = std::move(page.errorInfo);
+                    result->objects.insert(
+                        result->objects.end(),
+                        std::make_move_iterator(page.objects.begin()),
+                        std::make_move_iterator(page.objects.end())
+                    );
+                    result->commonPrefixes.insert(
+                        result->commonPrefixes.end(),
+                        std::make_move_iterator(page.commonPrefixes.begin()),
+                        std::make_move_iterator(page.commonPrefixes.end())
+                    );
+                    if (!page.isTruncated) {
+                        onCompletion(std::move(*result));
+                        return;
+                    }
+                    const auto nextContinuationToken = std::move(page.nextContinuationToken);
+                    self->Post(
+                        [self, bucketName, nextContinuationToken, options, result, onCompletion]{
+                            self->ListObjects(bucketName, nextContinuationToken, options, result, onCompletion);
+                        }
+                    );
+                }
+            );
+        }
+
+        /**
+         * List the objects in the given S3 bucket in compact form,
+         * starting with the page of results identified by the given
+         * continuation token, and continuing with the remaining pages.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket for which to list objects.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page of results to request, or is
+         *     empty to request the first page.
+         *
+         * @param[in] options
+         *     These select which objects to list, and how.
+         *
+         * @param[in] result
+         *     This is where the results from all the pages are collected.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results, once the
+         *     last page has been received.
+         */
+        void ListObjectsCompact(
+            const std::string& bucketName,
+            const std::string& continuationToken,
+            const ListObjectsOptions& options,
+            std::shared_ptr< CompactListObjectsResult > result,
+            CompactListObjectsDelegate onCompletion
+        ) {
+            const auto self = shared_from_this();
+            IssueRequest(
+                Operation::ListObjects,
+                MakeListObjectsRequest(bucketName, continuationToken, options),
+                [self, bucketName, options, result, onCompletion](const Http::IClient::Transaction& transaction){
+                    result->transactionState = transaction.state;
+                    result->statusCode = transaction.response.statusCode;
+                    if (transaction.state != Http::IClient::Transaction::State::Completed) {
+                        onCompletion(std::move(*result));
+                        return;
+                    }
+                    if (transaction.response.statusCode != 200) {
+                        result->errorInfo = XmlToJson(
+                            transaction.response.body,
+                            std::set< std::string >({})
+                        );
+                        onCompletion(std::move(*result));
+                        return;
+                    }
+                    std::string nextContinuationToken;
+                    {
+                        ParsingTimer parsingTimer;
+                        CompactObjectsPageHandler handler(*result);
+                        XmlParser parser(handler);
+                        if (!parser.Parse(transaction.response.body)) {
+                            result->transactionState = Http::IClient::Transaction::State::Broken;
+                        } else if (handler.IsTruncated()) {
+                            nextContinuationToken = std::move(handler.GetNextContinuationToken());
+                        }
+                    }
+                    if (nextContinuationToken.empty()) {
+                        onCompletion(std::move(*result));
+                        return;
+                    }
+                    self->Post(
+                        [self, bucketName, nextContinuationToken, options, result, onCompletion]{
+                            self->ListObjectsCompact(bucketName, nextContinuationToken, options, result, onCompletion);
+                        }
+                    );
+                }
+            );
+        }
+
+        /**
+         * Retrieve the given object from the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void GetObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            GetObjectDelegate onCompletion
+        ) {
+            auto request = MakeObjectRequest("GET", bucketName, objectName);
+            SignRequest(request);
+            IssueRequest(
+                Operation::GetObject,
+                std::move(request),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    GetObjectResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    result.headers = transaction.response.headers;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        if (transaction.response.statusCode == 200) {
+                            result.content = transaction.response.body;
+                            result.contentSize = result.content.length();
+                        } else {
+                            result.errorInfo = XmlToJson(
+                                transaction.response.body,
+                                std::set< std::string >({})
+                            );
+                        }
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * Build and sign a request for a range of bytes of an object in
+         * the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] offset
+         *     This is the offset of the first byte to request.
+         *
+         * @param[in] length
+         *     This is the number of bytes to request.  It must not
+         *     be zero.
+         *
+         * @param[in] eTag
+         *     If not empty, this is the entity tag the object must
+         *     have for the request to succeed.
+         *
+         * @return
+         *     The signed request is returned.
+         */
+        Http::Request MakeRangeRequest(
+            const std::string& bucketName,
+            const std::string& objectName,
+            size_t offset,
+            size_t length,
+            const std::string& eTag
+        ) {
+            auto request = MakeObjectRequest("GET", bucketName, objectName);
+            request.headers.AddHeader(
+                "Range",
+                StringExtensions::sprintf(
+                    "bytes=%zu-%zu",
+                    offset,
+                    offset + length - 1
+                )
+            );
+            if (!eTag.empty()) {
+                request.headers.AddHeader("If-Match", eTag);
+            }
+            SignRequest(request);
+            return request;
+        }
+
+        /**
+         * Retrieve a range of bytes of an object in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] offset
+         *     This is the offset of the first byte to retrieve.
+         *
+         * @param[in] length
+         *     This is the number of bytes to retrieve.  It must not
+         *     be zero.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void GetObjectRange(
+            const std::string& bucketName,
+            const std::string& objectName,
+            size_t offset,
+            size_t length,
+            GetObjectDelegate onCompletion
+        ) {
+            IssueRequest(
+                Operation::GetObject,
+                MakeRangeRequest(bucketName, objectName, offset, length, ""),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    GetObjectResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    result.headers = transaction.response.headers;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        if (
+                            (transaction.response.statusCode == 200)
+                            || (transaction.response.statusCode == 206)
+                        ) {
+                            result.content = transaction.response.body;
+                            result.contentSize = result.content.length();
+                        } else {
+                            result.errorInfo = XmlToJson(
+                                transaction.response.body,
+                                std::set< std::string >({})
+                            );
+                        }
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * Send the request for the given part of an object being
+         * downloaded, writing the part once it arrives, and requesting
+         * more parts as others finish.
+         *
+         * @param[in] download
+         *     This holds the state of the download.
+         *
+         * @param[in] offset
+         *     This is the offset of the first byte of the part.
+         */
+        void DownloadPart(
+            std::shared_ptr< Download > download,
+            size_t offset
+        ) {
+            std::string eTag;
+            {
+                std::lock_guard< decltype(download->mutex) > lock(download->mutex);
+                eTag = download->eTag;
+            }
+            const auto self = shared_from_this();
+            IssueRequest(
+                Operation::GetObject,
+                MakeRangeRequest(
+                    download->bucketName,
+                    download->objectName,
+                    offset,
+                    download->partSize,
+                    eTag
+                ),
+                [self, download, offset](const Http::IClient::Transaction& transaction){
+                    bool succeeded = false;
+                    bool sizeLearned = false;
+                    size_t first = 0, last = 0, totalSize = 0;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        if (transaction.response.statusCode == 206) {
+                            succeeded = (
+                                ParseContentRange(
+                                    transaction.response.headers.GetHeaderValue("Content-Range"),
+                                    first,
+                                    last,
+                                    totalSize
+                                )
+                                && (first == offset)
+                                && (last - first + 1 == transaction.response.body.length())
+                            );
+                        } else if (
+                            (transaction.response.statusCode == 200)
+                            && (offset == 0)
+                        ) {
+                            totalSize = transaction.response.body.length();
+                            succeeded = true;
+                        } else if (
+                            (transaction.response.statusCode == 416)
+                            && (offset == 0)
+                        ) {
+                            // S3 can't satisfy any range of an empty object.
+                            succeeded = true;
+                        }
+                    }
+                    if (
+                        succeeded
+                        && !transaction.response.body.empty()
+                    ) {
+                        succeeded = download->contentWriter(
+                            offset,
+                            transaction.response.body.data(),
+                            transaction.response.body.length()
+                        );
+                    }
+                    std::vector< size_t > partsToRequest;
+                    bool complete = false;
+                    {
+                        std::lock_guard< decltype(download->mutex) > lock(download->mutex);
+                        --download->partsInFlight;
+                        if (offset == 0) {
+                            download->result.headers = transaction.response.headers;
+                            if (succeeded) {
+                                download->totalSize = totalSize;
+                                download->eTag = transaction.response.headers.GetHeaderValue("ETag");
+                                if (transaction.response.statusCode == 200) {
+                                    // The server ignored the range and sent
+                                    // the whole object, so there are no
+                                    // more parts to request.
+                                    download->nextOffset = totalSize;
+                                }
+                                sizeLearned = true;
+                            }
+                        }
+                        if (succeeded) {
+                            download->result.contentSize += transaction.response.body.length();
+                        } else if (!download->failed) {
+                            download->failed = true;
+                            download->result.transactionState = transaction.state;
+                            download->result.statusCode = transaction.response.statusCode;
+                            if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                                if (
+                                    (transaction.response.statusCode == 200)
+                                    || (transaction.response.statusCode == 206)
+                                ) {
+                                    download->result.transactionState = Http::IClient::Transaction::State::Broken;
+                                } else {
+                                    download->result.errorInfo = XmlToJson(
+                                        transaction.response.body,
+                                        std::set< std::string >({})
+                                    );
+                                }
+                            }
+                        }
+                        if (sizeLearned || succeeded) {
+                            while (
+                                !download->failed
+                                && (download->partsInFlight < download->maxPartsInFlight)
+                                && (download->nextOffset < download->totalSize)
+                            ) {
+                                partsToRequest.push_back(download->nextOffset);
+                                download->nextOffset += download->partSize;
+                                ++download->partsInFlight;
+                            }
+                        }
+                        if (
+                            (download->partsInFlight == 0)
+                            && partsToRequest.empty()
+                        ) {
+                            complete = true;
+                            if (!download->failed) {
+                                download->result.transactionState = Http::IClient::Transaction::State::Completed;
+                                download->result.statusCode = 200;
+                            }
+                        }
+                    }
+                    for (const auto partOffset: partsToRequest) {
+                        self->Post(
+                            [self, download, partOffset]{
+                                self->DownloadPart(download, partOffset);
                             }
+                        );
+                    }
+                    if (complete) {
+                        download->onCompletion(std::move(download->result));
+                    }
+                }
+            );
+        }
+
+        /**
+         * Retrieve the contents of an object in the given S3 bucket,
+         * one range of bytes at a time, handing each range to the given
+         * sink as it arrives, starting with the range at the given offset
+         * and continuing with the remaining ranges.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket containing the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to retrieve.
+         *
+         * @param[in] contentSink
+         *     This is the function to call with each piece of the
+         *     object contents.
+         *
+         * @param[in] chunkSize
+         *     This is the number of bytes to request at a time.
+         *
+         * @param[in] offset
+         *     This is the offset of the first byte to request.
+         *
+         * @param[in] eTag
+         *     This is the entity tag of the object, as reported in the
+         *     response to the first request, or is empty if no request
+         *     has yet been made.  It's used to make sure every range
+         *     comes from the same version of the object.
+         *
+         * @param[in] result
+         *     This is where the results of the requests are collected.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results, once the
+         *     last range has been received.
+         */
+        void GetObjectChunks(
+            const std::string& bucketName,
+            const std::string& objectName,
+            ContentSink contentSink,
+            size_t chunkSize,
+            size_t offset,
+            const std::string& eTag,
+            std::shared_ptr< GetObjectResult > result,
+            GetObjectDelegate onCompletion
+        ) {
+            auto request = MakeRangeRequest(bucketName, objectName, offset, chunkSize, eTag);
+            const auto self = shared_from_this();
+            IssueRequest(
+                Operation::GetObject,
+                std::move(request),
+                [
+                    self, bucketName, objectName, contentSink, chunkSize,
+                    offset, eTag, result, onCompletion
+                ](const Http::IClient::Transaction& transaction){
+                    result->transactionState = transaction.state;
+                    result->statusCode = transaction.response.statusCode;
+                    if (offset == 0) {
+                        result->headers = transaction.response.headers;
+                    }
+                    if (transaction.state != Http::IClient::Transaction::State::Completed) {
+                        onCompletion(std::move(*result));
+                        return;
+                    }
+                    size_t totalSize = 0;
+                    size_t nextOffset = 0;
+                    if (transaction.response.statusCode == 206) {
+                        size_t first, last;
+                        if (
+                            !ParseContentRange(
+                                transaction.response.headers.GetHeaderValue("Content-Range"),
+                                first,
+                                last,
+                                totalSize
+                            )
+                        ) {
+                            result->transactionState = Http::IClient::Transaction::State::Broken;
+                            onCompletion(std::move(*result));
+                            return;
+                        }
+                        nextOffset = last + 1;
+                    } else if (transaction.response.statusCode == 200) {
+                        totalSize = nextOffset = transaction.response.body.length();
+                    } else if (
+                        (transaction.response.statusCode == 416)
+                        && (offset == 0)
+                    ) {
+                        // S3 can't satisfy any range of an empty object.
+                        result->statusCode = 200;
+                        onCompletion(std::move(*result));
+                        return;
+                    } else {
+                        result->errorInfo = XmlToJson(
+                            transaction.response.body,
+                            std::set< std::string >({})
+                        );
+                        onCompletion(std::move(*result));
+                        return;
+                    }
+                    if (
+                        !transaction.response.body.empty()
+                        && !contentSink(
+                            transaction.response.body.data(),
+                            transaction.response.body.length()
+                        )
+                    ) {
+                        result->transactionState = Http::IClient::Transaction::State::Broken;
+                        onCompletion(std::move(*result));
+                        return;
+                    }
+                    result->contentSize += transaction.response.body.length();
+                    if (nextOffset >= totalSize) {
+                        result->statusCode = 200;
+                        onCompletion(std::move(*result));
+                        return;
+                    }
+                    const auto nextETag = (
+                        eTag.empty()
+                        ? transaction.response.headers.GetHeaderValue("ETag")
+                        : eTag
+                    );
+                    self->Post(
+                        [
+                            self, bucketName, objectName, contentSink, chunkSize,
+                            nextOffset, nextETag, result, onCompletion
+                        ]{
+                            self->GetObjectChunks(
+                                bucketName,
+                                objectName,
+                                contentSink,
+                                chunkSize,
+                                nextOffset,
+                                nextETag,
+                                result,
+                                onCompletion
+                            );
+                        }
+                    );
+                }
+            );
+        }
+
+        /**
+         * Store an object in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] extraHeaders
+         *     This is a dictionary listing extra headers to include in the
+         *     API call.
+         *
+         * @param[in] payloadHeaders
+         *     This is a dictionary listing the headers which describe
+         *     the payload, such as its length and hash.
+         *
+         * @param[in] writeBody
+         *     This is the function to call, once the request has been
+         *     signed, to fill in the request body.  It returns an
+         *     indication of whether or not the whole body was written.
+         *     If not, the request isn't sent, and the results are
+         *     reported as a broken transaction.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void PutObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::map< std::string, std::string >& extraHeaders,
+            const std::map< std::string, std::string >& payloadHeaders,
+            std::function< bool(std::string& body, const SignApi::RequestSignature& signature) > writeBody,
+            PutObjectDelegate onCompletion
+        ) {
+            auto request = MakeObjectRequest("PUT", bucketName, objectName);
+            for (const auto& extraHeader: extraHeaders) {
+                request.headers.AddHeader(extraHeader.first, extraHeader.second);
+            }
+            for (const auto& payloadHeader: payloadHeaders) {
+                request.headers.SetHeader(payloadHeader.first, payloadHeader.second);
+            }
+            const auto& signature = SignRequest(request);
+            if (!writeBody(request.body, signature)) {
+                PutObjectResult result;
+                result.transactionState = Http::IClient::Transaction::State::Broken;
+                onCompletion(std::move(result));
+                return;
+            }
+            IssueRequest(
+                Operation::PutObject,
+                std::move(request),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    PutObjectResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    result.headers = transaction.response.headers;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        if (transaction.response.statusCode != 200) {
+                            result.errorInfo = XmlToJson(
+                                transaction.response.body,
+                                std::set< std::string >({})
+                            );
+                        }
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * Store the given contents as an object in the given S3 bucket.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] contents
+         *     This is the contents to store in the object.  Unless it's
+         *     sent in signed chunks, it's moved into the request rather
+         *     than copied.
+         *
+         * @param[in] payloadHash
+         *     If the payload is signed, this is the hex-encoded SHA-256
+         *     hash of the contents, which is used to sign the request
+         *     instead of hashing the contents again.
+         *
+         * @param[in] extraHeaders
+         *     This is a dictionary listing extra headers to include in the
+         *     API call.
+         *
+         * @param[in] payloadSigning
+         *     This indicates how the payload should be signed.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void PutObject(
+            const std::string& bucketName,
+            const std::string& objectName,
+            std::string&& contents,
+            const std::string& payloadHash,
+            const std::map< std::string, std::string >& extraHeaders,
+            PayloadSigning payloadSigning,
+            PutObjectDelegate onCompletion
+        ) {
+            std::map< std::string, std::string > payloadHeaders;
+            if (payloadSigning == PayloadSigning::Streaming) {
+                payloadHeaders["Content-Encoding"] = "aws-chunked";
+                payloadHeaders["Content-Length"] = StringExtensions::sprintf(
+                    "%zu",
+                    GetChunkedContentLength(contents.length())
+                );
+                payloadHeaders["x-amz-content-sha256"] = STREAMING_PAYLOAD;
+                payloadHeaders["x-amz-decoded-content-length"] = StringExtensions::sprintf(
+                    "%zu",
+                    contents.length()
+                );
+                PutObject(
+                    bucketName,
+                    objectName,
+                    extraHeaders,
+                    payloadHeaders,
+                    [this, &contents](
+                        std::string& body,
+                        const SignApi::RequestSignature& signature
+                    ) {
+                        body.reserve(GetChunkedContentLength(contents.length()));
+                        auto previousSignature = signature.signature;
+                        for (size_t offset = 0; offset < contents.length(); offset += CHUNK_SIZE) {
+                            AppendSignedChunk(
+                                body,
+                                contents.data() + offset,
+                                std::min(CHUNK_SIZE, contents.length() - offset),
+                                signature,
+                                previousSignature
+                            );
+                        }
+                        AppendSignedChunk(body, nullptr, 0, signature, previousSignature);
+                        return true;
+                    },
+                    onCompletion
+                );
+                return;
+            }
+            payloadHeaders["Content-Length"] = StringExtensions::sprintf("%zu", contents.length());
+            payloadHeaders["x-amz-content-sha256"] = (
+                (payloadSigning == PayloadSigning::Unsigned)
+                ? UNSIGNED_PAYLOAD
+                : payloadHash
+            );
+            PutObject(
+                bucketName,
+                objectName,
+                extraHeaders,
+                payloadHeaders,
+                [&contents](
+                    std::string& body,
+                    const SignApi::RequestSignature& signature
+                ) {
+                    body = std::move(contents);
+                    return true;
+                },
+                onCompletion
+            );
+        }
+
+        /**
+         * Store the contents supplied a piece at a time by the given source
+         * as an object in the given S3 bucket, sending the contents in
+         * signed chunks.  The contents are signed as they're read, a chunk
+         * at a time.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] contentSource
+         *     This is the function to call to read the contents to store
+         *     in the object.
+         *
+         * @param[in] contentLength
+         *     This is the exact size of the contents, in bytes.
+         *
+         * @param[in] extraHeaders
+         *     This is a dictionary listing extra headers to include in the
+         *     API call.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void PutObjectStreaming(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const ContentSource& contentSource,
+            size_t contentLength,
+            const std::map< std::string, std::string >& extraHeaders,
+            PutObjectDelegate onCompletion
+        ) {
+            std::map< std::string, std::string > payloadHeaders;
+            payloadHeaders["Content-Encoding"] = "aws-chunked";
+            payloadHeaders["Content-Length"] = StringExtensions::sprintf(
+                "%zu",
+                GetChunkedContentLength(contentLength)
+            );
+            payloadHeaders["x-amz-content-sha256"] = STREAMING_PAYLOAD;
+            payloadHeaders["x-amz-decoded-content-length"] = StringExtensions::sprintf(
+                "%zu",
+                contentLength
+            );
+            PutObject(
+                bucketName,
+                objectName,
+                extraHeaders,
+                payloadHeaders,
+                [this, &contentSource, contentLength](
+                    std::string& body,
+                    const SignApi::RequestSignature& signature
+                ) {
+                    body.reserve(GetChunkedContentLength(contentLength));
+                    std::vector< char > chunk(CHUNK_SIZE);
+                    auto previousSignature = signature.signature;
+                    size_t remaining = contentLength;
+                    while (remaining > 0) {
+                        const auto chunkLength = ReadFully(
+                            contentSource,
+                            chunk.data(),
+                            std::min(CHUNK_SIZE, remaining)
+                        );
+                        if (chunkLength == 0) {
+                            break;
+                        }
+                        AppendSignedChunk(body, chunk.data(), chunkLength, signature, previousSignature);
+                        remaining -= chunkLength;
+                    }
+
+                    // The length of the body has already been declared and
+                    // signed, so a source which runs dry early can't be
+                    // sent as it is.
+                    if (remaining > 0) {
+                        return false;
+                    }
+                    AppendSignedChunk(body, nullptr, 0, signature, previousSignature);
+                    return true;
+                },
+                onCompletion
+            );
+        }
+
+        /**
+         * Begin storing an object in the given S3 bucket in parts.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] extraHeaders
+         *     This is a dictionary listing extra headers to include in the
+         *     API call.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void CreateMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::map< std::string, std::string >& extraHeaders,
+            CreateMultipartUploadDelegate onCompletion
+        ) {
+            auto request = MakeObjectRequest("POST", bucketName, objectName);
+            request.target.SetQuery("uploads");
+            for (const auto& extraHeader: extraHeaders) {
+                request.headers.AddHeader(extraHeader.first, extraHeader.second);
+            }
+            request.headers.SetHeader("Content-Length", "0");
+            SignRequest(request);
+            IssueRequest(
+                Operation::CreateMultipartUpload,
+                std::move(request),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    CreateMultipartUploadResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    result.headers = transaction.response.headers;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        const auto parsedBody = XmlToJson(
+                            transaction.response.body,
+                            std::set< std::string >({})
+                        );
+                        if (transaction.response.statusCode == 200) {
+                            result.uploadId = (std::string)parsedBody["UploadId"];
+                        } else {
+                            result.errorInfo = parsedBody;
+                        }
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * Store one part of an object being stored in parts.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3.
+         *
+         * @param[in] partNumber
+         *     This is the number of the part, from 1 to 10000.
+         *
+         * @param[in] contents
+         *     This is the contents of the part.  It's moved into the
+         *     request rather than copied.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void UploadPart(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId,
+            unsigned int partNumber,
+            std::string&& contents,
+            UploadPartDelegate onCompletion
+        ) {
+            auto request = MakeObjectRequest("PUT", bucketName, objectName);
+            request.target.SetQuery(
+                StringExtensions::sprintf("partNumber=%u&uploadId=", partNumber)
+                + SignApi::AmzUriEncode(uploadId)
+            );
+            request.headers.SetHeader(
+                "Content-Length",
+                StringExtensions::sprintf("%zu", contents.length())
+            );
+            request.body = std::move(contents);
+            SignRequest(request);
+            IssueRequest(
+                Operation::UploadPart,
+                std::move(request),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    UploadPartResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    result.headers = transaction.response.headers;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        if (transaction.response.statusCode == 200) {
+                            result.eTag = transaction.response.headers.GetHeaderValue("ETag");
                         } else {
                             result.errorInfo = XmlToJson(
-                                transaction->response.body,
+                                transaction.response.body,
                                 std::set< std::string >({})
                             );
-                            break;
                         }
-                    } else {
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * Finish storing an object in parts, combining the given parts
+         * to form the object.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which to store the object.
+         *
+         * @param[in] objectName
+         *     This is the name of the object to store.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3.
+         *
+         * @param[in] parts
+         *     These identify the parts to combine, in order.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void CompleteMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId,
+            const std::vector< CompletedPart >& parts,
+            CompleteMultipartUploadDelegate onCompletion
+        ) {
+            auto request = MakeObjectRequest("POST", bucketName, objectName);
+            request.target.SetQuery("uploadId=" + SignApi::AmzUriEncode(uploadId));
+            request.body = "<CompleteMultipartUpload>";
+            for (const auto& part: parts) {
+                request.body += StringExtensions::sprintf(
+                    "<Part><PartNumber>%u</PartNumber><ETag>",
+                    part.partNumber
+                );
+                request.body += part.eTag;
+                request.body += "</ETag></Part>";
+            }
+            request.body += "</CompleteMultipartUpload>";
+            request.headers.SetHeader(
+                "Content-Length",
+                StringExtensions::sprintf("%zu", request.body.length())
+            );
+            SignRequest(request);
+            IssueRequest(
+                Operation::CompleteMultipartUpload,
+                std::move(request),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    CompleteMultipartUploadResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    result.headers = transaction.response.headers;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        const auto parsedBody = XmlToJson(
+                            transaction.response.body,
+                            std::set< std::string >({})
+                        );
+                        // S3 may report an error after it has already
+                        // responded with status 200, in which case it puts
+                        // an "Error" element in the body instead of the
+                        // results.
+                        if (
+                            (transaction.response.statusCode == 200)
+                            && (transaction.response.body.find("<Error>") == std::string::npos)
+                        ) {
+                            result.eTag = parsedBody["ETag"];
+                        } else {
+                            result.errorInfo = parsedBody;
+                        }
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * Abandon storing an object in parts, discarding any parts
+         * already stored.
+         *
+         * @param[in] bucketName
+         *     This is the name of the bucket in which the object was
+         *     being stored.
+         *
+         * @param[in] objectName
+         *     This is the name of the object which was being stored.
+         *
+         * @param[in] uploadId
+         *     This identifies the multipart upload to S3.
+         *
+         * @param[in] onCompletion
+         *     This is the function to call with the results of the S3
+         *     request, once it's complete.
+         */
+        void AbortMultipartUpload(
+            const std::string& bucketName,
+            const std::string& objectName,
+            const std::string& uploadId,
+            AbortMultipartUploadDelegate onCompletion
+        ) {
+            auto request = MakeObjectRequest("DELETE", bucketName, objectName);
+            request.target.SetQuery("uploadId=" + SignApi::AmzUriEncode(uploadId));
+            SignRequest(request);
+            IssueRequest(
+                Operation::AbortMultipartUpload,
+                std::move(request),
+                [onCompletion](const Http::IClient::Transaction& transaction){
+                    AbortMultipartUploadResult result;
+                    result.transactionState = transaction.state;
+                    result.statusCode = transaction.response.statusCode;
+                    if (transaction.state == Http::IClient::Transaction::State::Completed) {
+                        if (transaction.response.statusCode != 204) {
+                            result.errorInfo = XmlToJson(
+                                transaction.response.body,
+                                std::set< std::string >({})
+                            );
+                        }
+                    }
+                    onCompletion(std::move(result));
+                }
+            );
+        }
+
+        /**
+         * Read and upload parts of an object being uploaded, until either
+         * the maximum number of parts are in flight, the contents are
+         * exhausted, or a part fails, and then complete or abort the
+         * upload if there's nothing left to do.
+         *
+         * @param[in] upload
+         *     This holds the state of the upload.
+         */
+        void PumpUpload(std::shared_ptr< Upload > upload) {
+            for (;;) {
+                unsigned int partNumber;
+                {
+                    std::lock_guard< decltype(upload->mutex) > lock(upload->mutex);
+                    if (
+                        upload->reading
+                        || upload->failed
+                        || upload->sourceExhausted
+                        || (upload->partsInFlight >= upload->maxPartsInFlight)
+                    ) {
+                        break;
+                    }
+                    upload->reading = true;
+                    partNumber = upload->nextPartNumber;
+                }
+                const auto part = std::make_shared< std::string >();
+                part->resize(upload->partSize);
+                part->resize(ReadFully(upload->contentSource, &(*part)[0], upload->partSize));
+                {
+                    std::lock_guard< decltype(upload->mutex) > lock(upload->mutex);
+                    upload->reading = false;
+                    if (part->length() < upload->partSize) {
+                        upload->sourceExhausted = true;
+                    }
+
+                    // An object always has at least one part, even if it's
+                    // empty.
+                    if (
+                        part->empty()
+                        && (partNumber > 1)
+                    ) {
+                        break;
+                    }
+
+                    // S3 would only reject an object with too many parts
+                    // once all of them were uploaded, so give up as soon
+                    // as the contents turn out to be too large.
+                    if (partNumber > MAX_UPLOAD_PARTS) {
+                        if (!upload->failed) {
+                            upload->failed = true;
+                            upload->result.transactionState = Http::IClient::Transaction::State::Broken;
+                        }
                         break;
                     }
-                } while (!continuationToken.empty());
-                return result;
+                    ++upload->nextPartNumber;
+                    ++upload->partsInFlight;
+                }
+                UploadPartAttempt(upload, partNumber, part, 1);
+            }
+            FinishUploadIfDone(upload);
+        }
+
+        /**
+         * Make an attempt to upload a part of an object being uploaded.
+         *
+         * @param[in] upload
+         *     This holds the state of the upload.
+         *
+         * @param[in] partNumber
+         *     This is the number of the part.
+         *
+         * @param[in] part
+         *     This is the contents of the part.  It's kept for as long as
+         *     the part might need to be uploaded again, and moved into the
+         *     request for the last attempt allowed.
+         *
+         * @param[in] attempt
+         *     This is the number of the attempt, starting from 1.
+         */
+        void UploadPartAttempt(
+            std::shared_ptr< Upload > upload,
+            unsigned int partNumber,
+            std::shared_ptr< std::string > part,
+            size_t attempt
+        ) {
+            const auto self = shared_from_this();
+            retriesOfNextRequest = attempt - 1;
+            UploadPart(
+                upload->bucketName,
+                upload->objectName,
+                upload->uploadId,
+                partNumber,
+                (
+                    (attempt < upload->maxAttemptsPerPart)
+                    ? std::string(*part)
+                    : std::move(*part)
+                ),
+                [self, upload, partNumber, part, attempt](UploadPartResult result){
+                    const bool succeeded = (
+                        (result.transactionState == Http::IClient::Transaction::State::Completed)
+                        && (result.statusCode == 200)
+                    );
+                    const bool retryable = (
+                        (result.transactionState != Http::IClient::Transaction::State::Completed)
+                        || (result.statusCode >= 500)
+                    );
+                    if (
+                        !succeeded
+                        && retryable
+                        && (attempt < upload->maxAttemptsPerPart)
+                    ) {
+                        // Back off before trying again, doubling the wait
+                        // with each attempt, to give the server a chance
+                        // to recover.
+                        const auto delay = std::min(
+                            RETRY_MAX_DELAY,
+                            RETRY_BASE_DELAY * (1 << std::min(attempt - 1, (size_t)16))
+                        );
+                        self->Post(
+                            [self, upload, partNumber, part, attempt]{
+                                self->UploadPartAttempt(upload, partNumber, part, attempt + 1);
+                            },
+                            delay
+                        );
+                        return;
+                    }
+                    {
+                        std::lock_guard< decltype(upload->mutex) > lock(upload->mutex);
+                        --upload->partsInFlight;
+                        if (succeeded) {
+                            CompletedPart completedPart;
+                            completedPart.partNumber = partNumber;
+                            completedPart.eTag = result.eTag;
+                            upload->completedParts.push_back(std::move(completedPart));
+                        } else if (!upload->failed) {
+                            upload->failed = true;
+                            upload->result.transactionState = result.transactionState;
+                            upload->result.statusCode = result.statusCode;
+                            upload->result.headers = std::move(result.headers);
+                            upload->result.errorInfo = std::move(result.errorInfo);
+                        }
+                    }
+                    self->Post(
+                        [self, upload]{
+                            self->PumpUpload(upload);
+                        }
+                    );
+                }
+            );
+        }
+
+        /**
+         * Complete the given upload, if all its parts have been uploaded,
+         * or abort it, if any part failed and no others are in flight.
+         *
+         * @param[in] upload
+         *     This holds the state of the upload.
+         */
+        void FinishUploadIfDone(std::shared_ptr< Upload > upload) {
+            std::vector< CompletedPart > completedParts;
+            bool failed;
+            {
+                std::lock_guard< decltype(upload->mutex) > lock(upload->mutex);
+                if (
+                    upload->finishing
+                    || upload->reading
+                    || (upload->partsInFlight > 0)
+                    || !(
+                        upload->failed
+                        || upload->sourceExhausted
+                    )
+                ) {
+                    return;
+                }
+                upload->finishing = true;
+                failed = upload->failed;
+                completedParts.swap(upload->completedParts);
+            }
+            if (failed) {
+                AbortMultipartUpload(
+                    upload->bucketName,
+                    upload->objectName,
+                    upload->uploadId,
+                    [upload](AbortMultipartUploadResult result){
+                        upload->onCompletion(std::move(upload->result));
+                    }
+                );
+            } else {
+                std::sort(
+                    completedParts.begin(),
+                    completedParts.end(),
+                    [](
+                        const CompletedPart& lhs,
+                        const CompletedPart& rhs
+                    ) {
+                        return (lhs.partNumber < rhs.partNumber);
+                    }
+                );
+                CompleteMultipartUpload(
+                    upload->bucketName,
+                    upload->objectName,
+                    upload->uploadId,
+                    completedParts,
+                    upload->onCompletion
+                );
+            }
+        }
+
+        /**
+         * Start listing as many partitions of the given listing as it
+         * allows, or finish the listing if all partitions have been listed.
+         *
+         * @param[in] listing
+         *     This holds the state of the listing.
+         */
+        void PumpListing(std::shared_ptr< Listing > listing) {
+            std::vector< size_t > partitionsToStart;
+            bool finish = false;
+            {
+                std::lock_guard< decltype(listing->mutex) > lock(listing->mutex);
+                while (
+                    !listing->failed
+                    && (listing->nextPartition < listing->partitions.size())
+                    && (listing->partitionsInFlight < listing->maxPartitionsInFlight)
+                ) {
+                    partitionsToStart.push_back(listing->nextPartition++);
+                    ++listing->partitionsInFlight;
+                }
+                if (
+                    partitionsToStart.empty()
+                    && (listing->partitionsInFlight == 0)
+                ) {
+                    if (listing->finishing) {
+                        return;
+                    }
+                    listing->finishing = true;
+                    finish = true;
+                }
+            }
+            if (finish) {
+                FinishListing(listing);
+                return;
+            }
+            const auto self = shared_from_this();
+            for (const auto partition: partitionsToStart) {
+                Post(
+                    [self, listing, partition]{
+                        self->ListPartition(listing, partition, "");
+                    }
+                );
+            }
+        }
+
+        /**
+         * List the next page of the given partition of the given listing.
+         *
+         * @param[in] listing
+         *     This holds the state of the listing.
+         *
+         * @param[in] partition
+         *     This is the index of the partition to list.
+         *
+         * @param[in] continuationToken
+         *     This identifies the page of results to request, or is
+         *     empty to request the first page of the partition.
+         */
+        void ListPartition(
+            std::shared_ptr< Listing > listing,
+            size_t partition,
+            const std::string& continuationToken
+        ) {
+            auto options = listing->options;
+            if (partition > 0) {
+                options.startAfter = std::max(
+                    options.startAfter,
+                    listing->splitPoints[partition - 1]
+                );
+            }
+            const auto self = shared_from_this();
+            ListObjectsPage(
+                listing->bucketName,
+                continuationToken,
+                options,
+                [self, listing, partition](ListObjectsPageResult page){
+                    const auto lastKey = (
+                        (partition < listing->splitPoints.size())
+                        ? &listing->splitPoints[partition]
+                        : nullptr
+                    );
+                    const auto isInPartition = [lastKey](const std::string& key){
+                        return (
+                            (lastKey == nullptr)
+                            || (key <= *lastKey)
+                        );
+                    };
+                    bool partitionDone = !page.isTruncated;
+                    {
+                        std::lock_guard< decltype(listing->mutex) > lock(listing->mutex);
+                        auto& result = listing->partitions[partition];
+                        result.transactionState = page.transactionState;
+                        result.statusCode = page.statusCode;
+                        result.errorInfo = std::move(page.errorInfo);
+                        if (
+                            (page.transactionState != Http::IClient::Transaction::State::Completed)
+                            || (page.statusCode != 200)
+                        ) {
+                            listing->failed = true;
+                        }
+                        if (listing->failed) {
+                            partitionDone = true;
+                        }
+                        for (auto& object: page.objects) {
+                            if (!isInPartition(object.key)) {
+                                partitionDone = true;
+                                break;
+                            }
+                            result.objects.push_back(std::move(object));
+                        }
+                        for (auto& commonPrefix: page.commonPrefixes) {
+                            if (!isInPartition(commonPrefix)) {
+                                partitionDone = true;
+                                break;
+                            }
+                            result.commonPrefixes.push_back(std::move(commonPrefix));
+                        }
+                        if (partitionDone) {
+                            --listing->partitionsInFlight;
+                        }
+                    }
+                    if (partitionDone) {
+                        self->Post(
+                            [self, listing]{
+                                self->PumpListing(listing);
+                            }
+                        );
+                    } else {
+                        const auto nextContinuationToken = std::move(page.nextContinuationToken);
+                        self->Post(
+                            [self, listing, partition, nextContinuationToken]{
+                                self->ListPartition(listing, partition, nextContinuationToken);
+                            }
+                        );
+                    }
+                }
+            );
+        }
+
+        /**
+         * Merge the results of listing the partitions of the given listing,
+         * in order, and report them.
+         *
+         * @param[in] listing
+         *     This holds the state of the listing.
+         */
+        void FinishListing(std::shared_ptr< Listing > listing) {
+            ListObjectsResult result;
+            size_t numObjects = 0;
+            for (const auto& partition: listing->partitions) {
+                numObjects += partition.objects.size();
+            }
+            result.objects.reserve(numObjects);
+            bool failureReported = false;
+            for (auto& partition: listing->partitions) {
+                const bool succeeded = (
+                    (partition.transactionState == Http::IClient::Transaction::State::Completed)
+                    && (partition.statusCode == 200)
+                );
+
+                // Report the results of the first partition which failed,
+                // if any, skipping partitions which were never started.
+                if (
+                    !failureReported
+                    && (
+                        succeeded
+                        || (partition.transactionState != Http::IClient::Transaction::State::InProgress)
+                    )
+                ) {
+                    result.transactionState = partition.transactionState;
+                    result.statusCode = partition.statusCode;
+                    result.errorInfo = std::move(partition.errorInfo);
+                    failureReported = !succeeded;
+                }
+                result.objects.insert(
+                    result.objects.end(),
+                    std::make_move_iterator(partition.objects.begin()),
+                    std::make_move_iterator(partition.objects.end())
+                );
+                result.commonPrefixes.insert(
+                    result.commonPrefixes.end(),
+                    std::make_move_iterator(partition.commonPrefixes.begin()),
+                    std::make_move_iterator(partition.commonPrefixes.end())
+                );
+            }
+
+            // A common prefix spanning a split point is reported by the
+            // partitions on both sides of it.
+            result.commonPrefixes.erase(
+                std::unique(
+                    result.commonPrefixes.begin(),
+                    result.commonPrefixes.end()
+                ),
+                result.commonPrefixes.end()
+            );
+            listing->partitions.clear();
+            listing->onCompletion(std::move(result));
+        }
+    };
+
+    /**
+     * This contains the private properties of an ObjectPages instance.
+     */
+    struct S3::ObjectPages::Impl {
+        /**
+         * These are the private properties of the S3 object used to make
+         * the requests.
+         */
+        std::shared_ptr< S3::Impl > s3;
+
+        /**
+         * This is the name of the bucket whose objects are listed.
+         */
+        std::string bucketName;
+
+        /**
+         * These select which objects to list, and how.
+         */
+        ListObjectsOptions options;
+
+        /**
+         * This indicates whether or not to request each page as soon as
+         * the one before it arrives.
+         */
+        bool prefetch = true;
+
+        /**
+         * This identifies the next page to request.
+         */
+        std::string nextContinuationToken;
+
+        /**
+         * This indicates whether or not the last page has been returned.
+         */
+        bool done = false;
+
+        /**
+         * This is the page which has been requested but not yet returned,
+         * if any.
+         */
+        std::future< ListObjectsPageResult > nextPage;
+
+        /**
+         * This is the page at which iteration currently stands.
+         */
+        ListObjectsPageResult currentPage;
+
+        /**
+         * Request the next page of objects.
+         */
+        void RequestNextPage() {
+            const auto promise = std::make_shared< std::promise< ListObjectsPageResult > >();
+            nextPage = promise->get_future();
+            const auto impl = s3;
+            const auto bucketName = this->bucketName;
+            const auto continuationToken = nextContinuationToken;
+            const auto options = this->options;
+            impl->Post(
+                [impl, bucketName, continuationToken, options, promise]{
+                    impl->ListObjectsPage(
+                        bucketName,
+                        continuationToken,
+                        options,
+                        [promise](ListObjectsPageResult result){
+                            promise->set_value(std::move(result));
+                        }
+                    );
+                }
+            );
+        }
+    };
+
+    S3::ObjectPages::iterator::iterator(ObjectPages* pages)
+        : pages_(pages)
+    {
+    }
+
+    auto S3::ObjectPages::iterator::operator*() const -> reference {
+        return pages_->impl_->currentPage;
+    }
+
+    auto S3::ObjectPages::iterator::operator->() const -> pointer {
+        return &pages_->impl_->currentPage;
+    }
+
+    auto S3::ObjectPages::iterator::operator++() -> iterator& {
+        if (!pages_->GetNextPage(pages_->impl_->currentPage)) {
+            pages_ = nullptr;
+        }
+        return *this;
+    }
+
+    bool S3::ObjectPages::iterator::operator==(const iterator& other) const {
+        return pages_ == other.pages_;
+    }
+
+    bool S3::ObjectPages::iterator::operator!=(const iterator& other) const {
+        return pages_ != other.pages_;
+    }
+
+    S3::ObjectPages::~ObjectPages() noexcept = default;
+    S3::ObjectPages::ObjectPages(ObjectPages&&) noexcept = default;
+    S3::ObjectPages& S3::ObjectPages::operator=(ObjectPages&&) noexcept = default;
+
+    S3::ObjectPages::ObjectPages(std::unique_ptr< Impl >&& impl)
+        : impl_(std::move(impl))
+    {
+    }
+
+    bool S3::ObjectPages::GetNextPage(ListObjectsPageResult& page) {
+        if (impl_->done) {
+            return false;
+        }
+        if (!impl_->nextPage.valid()) {
+            impl_->RequestNextPage();
+        }
+        page = impl_->nextPage.get();
+        if (page.isTruncated) {
+            impl_->nextContinuationToken = page.nextContinuationToken;
+            if (impl_->prefetch) {
+                impl_->RequestNextPage();
+            }
+        } else {
+            impl_->done = true;
+        }
+        return true;
+    }
+
+    auto S3::ObjectPages::begin() -> iterator {
+        return ++iterator(this);
+    }
+
+    auto S3::ObjectPages::end() -> iterator {
+        return iterator();
+    }
+
+    S3::~S3() noexcept = default;
+    S3::S3(S3&& other) noexcept = default;
+    S3& S3::operator=(S3&& other) noexcept = default;
+
+    S3::S3()
+        : impl_(new Impl)
+    {
+    }
+
+    void S3::Configure(
+        std::shared_ptr< Http::IClient > http,
+        Config config,
+        std::shared_ptr< WorkerPool > workerPool,
+        std::shared_ptr< TimestampProvider > timestampProvider
+    ) {
+        impl_->http = http;
+        impl_->config = config;
+        if (workerPool == nullptr) {
+            workerPool = std::make_shared< WorkerPool >(DEFAULT_WORKER_POOL_SIZE);
+        }
+        impl_->workerPool = workerPool;
+        if (timestampProvider == nullptr) {
+            timestampProvider = std::make_shared< TimestampProvider >();
+        }
+        impl_->timestampProvider = timestampProvider;
+    }
+
+    void S3::SetMetricsObserver(std::shared_ptr< MetricsObserver > metricsObserver) {
+        impl_->metricsObserver = metricsObserver;
+    }
+
+    const char* S3::GetOperationName(Operation operation) {
+        switch (operation) {
+            case Operation::ListBuckets: {
+                return "ListBuckets";
+            }
+
+            case Operation::ListObjects: {
+                return "ListObjects";
+            }
+
+            case Operation::GetObject: {
+                return "GetObject";
+            }
+
+            case Operation::PutObject: {
+                return "PutObject";
+            }
+
+            case Operation::CreateMultipartUpload: {
+                return "CreateMultipartUpload";
+            }
+
+            case Operation::UploadPart: {
+                return "UploadPart";
+            }
+
+            case Operation::CompleteMultipartUpload: {
+                return "CompleteMultipartUpload";
+            }
+
+            case Operation::AbortMultipartUpload: {
+                return "AbortMultipartUpload";
+            }
+
+            default: {
+                return "";
+            }
+        }
+    }
+
+    auto S3::ListBuckets() -> std::future< ListBucketsResult > {
+        const auto promise = std::make_shared< std::promise< ListBucketsResult > >();
+        auto future = promise->get_future();
+        ListBuckets(
+            [promise](ListBucketsResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::ListBuckets(ListBucketsDelegate onCompletion) {
+        auto impl(impl_);
+        impl->Post(
+            [impl, onCompletion]{
+                impl->ListBuckets(onCompletion);
+            }
+        );
+    }
+
+    auto S3::ListObjects(const std::string& bucketName) -> std::future< ListObjectsResult > {
+        return ListObjects(bucketName, ListObjectsOptions());
+    }
+
+    auto S3::ListObjects(
+        const std::string& bucketName,
+        const ListObjectsOptions& options
+    ) -> std::future< ListObjectsResult > {
+        const auto promise = std::make_shared< std::promise< ListObjectsResult > >();
+        auto future = promise->get_future();
+        ListObjects(
+            bucketName,
+            options,
+            [promise](ListObjectsResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::ListObjects(
+        const std::string& bucketName,
+        ListObjectsDelegate onCompletion
+    ) {
+        ListObjects(bucketName, ListObjectsOptions(), onCompletion);
+    }
+
+    void S3::ListObjects(
+        const std::string& bucketName,
+        const ListObjectsOptions& options,
+        ListObjectsDelegate onCompletion
+    ) {
+        auto impl(impl_);
+        impl->Post(
+            [impl, bucketName, options, onCompletion]{
+                impl->ListObjects(
+                    bucketName,
+                    "",
+                    options,
+                    std::make_shared< ListObjectsResult >(),
+                    onCompletion
+                );
+            }
+        );
+    }
+
+    auto S3::ListObjectsCompact(const std::string& bucketName) -> std::future< CompactListObjectsResult > {
+        return ListObjectsCompact(bucketName, ListObjectsOptions());
+    }
+
+    auto S3::ListObjectsCompact(
+        const std::string& bucketName,
+        const ListObjectsOptions& options
+    ) -> std::future< CompactListObjectsResult > {
+        const auto promise = std::make_shared< std::promise< CompactListObjectsResult > >();
+        auto future = promise->get_future();
+        ListObjectsCompact(
+            bucketName,
+            options,
+            [promise](CompactListObjectsResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::ListObjectsCompact(
+        const std::string& bucketName,
+        CompactListObjectsDelegate onCompletion
+    ) {
+        ListObjectsCompact(bucketName, ListObjectsOptions(), onCompletion);
+    }
+
+    void S3::ListObjectsCompact(
+        const std::string& bucketName,
+        const ListObjectsOptions& options,
+        CompactListObjectsDelegate onCompletion
+    ) {
+        auto impl(impl_);
+        impl->Post(
+            [impl, bucketName, options, onCompletion]{
+                impl->ListObjectsCompact(
+                    bucketName,
+                    "",
+                    options,
+                    std::make_shared< CompactListObjectsResult >(),
+                    onCompletion
+                );
+            }
+        );
+    }
+
+    auto S3::ListObjectsPage(
+        const std::string& bucketName,
+        const std::string& continuationToken
+    ) -> std::future< ListObjectsPageResult > {
+        return ListObjectsPage(bucketName, continuationToken, ListObjectsOptions());
+    }
+
+    auto S3::ListObjectsPage(
+        const std::string& bucketName,
+        const std::string& continuationToken,
+        const ListObjectsOptions& options
+    ) -> std::future< ListObjectsPageResult > {
+        const auto promise = std::make_shared< std::promise< ListObjectsPageResult > >();
+        auto future = promise->get_future();
+        ListObjectsPage(
+            bucketName,
+            continuationToken,
+            options,
+            [promise](ListObjectsPageResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::ListObjectsPage(
+        const std::string& bucketName,
+        const std::string& continuationToken,
+        ListObjectsPageDelegate onCompletion
+    ) {
+        ListObjectsPage(bucketName, continuationToken, ListObjectsOptions(), onCompletion);
+    }
+
+    void S3::ListObjectsPage(
+        const std::string& bucketName,
+        const std::string& continuationToken,
+        const ListObjectsOptions& options,
+        ListObjectsPageDelegate onCompletion
+    ) {
+        auto impl(impl_);
+        impl->Post(
+            [impl, bucketName, continuationToken, options, onCompletion]{
+                impl->ListObjectsPage(bucketName, continuationToken, options, onCompletion);
+            }
+        );
+    }
+
+    auto S3::ListObjectsInPages(
+        const std::string& bucketName,
+        bool prefetch
+    ) -> ObjectPages {
+        return ListObjectsInPages(bucketName, ListObjectsOptions(), prefetch);
+    }
+
+    auto S3::ListObjectsInPages(
+        const std::string& bucketName,
+        const ListObjectsOptions& options,
+        bool prefetch
+    ) -> ObjectPages {
+        std::unique_ptr< ObjectPages::Impl > pagesImpl(new ObjectPages::Impl());
+        pagesImpl->s3 = impl_;
+        pagesImpl->bucketName = bucketName;
+        pagesImpl->options = options;
+        pagesImpl->prefetch = prefetch;
+        return ObjectPages(std::move(pagesImpl));
+    }
+
+    auto S3::ListObjectsInParallel(
+        const std::string& bucketName,
+        const std::vector< std::string >& splitPoints,
+        size_t maxPartitionsInFlight
+    ) -> std::future< ListObjectsResult > {
+        return ListObjectsInParallel(
+            bucketName,
+            splitPoints,
+            ListObjectsOptions(),
+            maxPartitionsInFlight
+        );
+    }
+
+    auto S3::ListObjectsInParallel(
+        const std::string& bucketName,
+        const std::vector< std::string >& splitPoints,
+        const ListObjectsOptions& options,
+        size_t maxPartitionsInFlight
+    ) -> std::future< ListObjectsResult > {
+        const auto promise = std::make_shared< std::promise< ListObjectsResult > >();
+        auto future = promise->get_future();
+        ListObjectsInParallel(
+            bucketName,
+            splitPoints,
+            options,
+            [promise](ListObjectsResult result){
+                promise->set_value(std::move(result));
+            },
+            maxPartitionsInFlight
+        );
+        return future;
+    }
+
+    void S3::ListObjectsInParallel(
+        const std::string& bucketName,
+        const std::vector< std::string >& splitPoints,
+        ListObjectsDelegate onCompletion,
+        size_t maxPartitionsInFlight
+    ) {
+        ListObjectsInParallel(
+            bucketName,
+            splitPoints,
+            ListObjectsOptions(),
+            onCompletion,
+            maxPartitionsInFlight
+        );
+    }
+
+    void S3::ListObjectsInParallel(
+        const std::string& bucketName,
+        const std::vector< std::string >& splitPoints,
+        const ListObjectsOptions& options,
+        ListObjectsDelegate onCompletion,
+        size_t maxPartitionsInFlight
+    ) {
+        const auto listing = std::make_shared< Impl::Listing >();
+        listing->bucketName = bucketName;
+        listing->options = options;
+        listing->splitPoints = splitPoints;
+        std::sort(listing->splitPoints.begin(), listing->splitPoints.end());
+        listing->splitPoints.erase(
+            std::unique(listing->splitPoints.begin(), listing->splitPoints.end()),
+            listing->splitPoints.end()
+        );
+        listing->maxPartitionsInFlight = std::max(maxPartitionsInFlight, (size_t)1);
+        listing->partitions.resize(listing->splitPoints.size() + 1);
+        listing->onCompletion = onCompletion;
+        auto impl(impl_);
+        impl->Post(
+            [impl, listing]{
+                impl->PumpListing(listing);
             }
         );
     }
@@ -442,126 +3582,624 @@ namespace Aws {
         const std::string& bucketName,
         const std::string& objectName
     ) -> std::future< GetObjectResult > {
+        const auto promise = std::make_shared< std::promise< GetObjectResult > >();
+        auto future = promise->get_future();
+        GetObject(
+            bucketName,
+            objectName,
+            [promise](GetObjectResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::GetObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        GetObjectDelegate onCompletion
+    ) {
         auto impl(impl_);
-        return std::async(
-            std::launch::async,
-            [impl, bucketName, objectName]{
-                GetObjectResult result;
-                const auto host = "s3." + impl->config.region + ".amazonaws.com";
-                const auto date = AmzTimestamp(time(NULL));
-                Http::Request request;
-                request.method = "GET";
-                request.target.SetHost(host);
-                request.target.SetPort(443);
-                auto objectNameParts = Split(objectName, '/');
-                objectNameParts.insert(objectNameParts.begin(), {"", bucketName});
-                request.target.SetPath(objectNameParts);
-                request.headers.AddHeader("Host", host);
-                request.headers.AddHeader("x-amz-date", date);
-                const auto canonicalRequest = SignApi::ConstructCanonicalRequest(request.Generate());
-                const auto payloadHashOffset = canonicalRequest.find_last_of('\n') + 1;
-                const auto payloadHash = canonicalRequest.substr(payloadHashOffset);
-                const auto stringToSign = SignApi::MakeStringToSign(
-                    impl->config.region,
-                    "s3",
-                    canonicalRequest
-                );
-                const auto authorization = SignApi::MakeAuthorization(
-                    stringToSign,
-                    canonicalRequest,
-                    impl->config.accessKeyId,
-                    impl->config.secretAccessKey
+        impl->Post(
+            [impl, bucketName, objectName, onCompletion]{
+                impl->GetObject(bucketName, objectName, onCompletion);
+            }
+        );
+    }
+
+    auto S3::GetObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        ContentSink contentSink,
+        size_t chunkSize
+    ) -> std::future< GetObjectResult > {
+        const auto promise = std::make_shared< std::promise< GetObjectResult > >();
+        auto future = promise->get_future();
+        GetObject(
+            bucketName,
+            objectName,
+            contentSink,
+            [promise](GetObjectResult result){
+                promise->set_value(std::move(result));
+            },
+            chunkSize
+        );
+        return future;
+    }
+
+    void S3::GetObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        ContentSink contentSink,
+        GetObjectDelegate onCompletion,
+        size_t chunkSize
+    ) {
+        auto impl(impl_);
+        chunkSize = std::max(chunkSize, (size_t)1);
+        impl->Post(
+            [impl, bucketName, objectName, contentSink, onCompletion, chunkSize]{
+                impl->GetObjectChunks(
+                    bucketName,
+                    objectName,
+                    contentSink,
+                    chunkSize,
+                    0,
+                    "",
+                    std::make_shared< GetObjectResult >(),
+                    onCompletion
                 );
-                request.headers.AddHeader("Authorization", authorization);
-                request.headers.AddHeader("x-amz-content-sha256", payloadHash);
-                if (!impl->config.sessionToken.empty()) {
-                    request.headers.AddHeader("x-amz-security-token", impl->config.sessionToken);
-                }
-                const auto rawRequest = request.Generate();
-                const auto transaction = impl->http->Request(request);
-                transaction->AwaitCompletion();
-                result.transactionState = transaction->state;
-                result.statusCode = transaction->response.statusCode;
-                result.headers = transaction->response.headers;
-                if (transaction->state == Http::IClient::Transaction::State::Completed) {
-                    if (transaction->response.statusCode == 200) {
-                        result.content = transaction->response.body;
-                    } else {
-                        result.errorInfo = XmlToJson(
-                            transaction->response.body,
-                            std::set< std::string >({})
-                        );
-                    }
+            }
+        );
+    }
+
+    auto S3::GetObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        char* buffer,
+        size_t bufferSize
+    ) -> std::future< GetObjectResult > {
+        const auto promise = std::make_shared< std::promise< GetObjectResult > >();
+        auto future = promise->get_future();
+        GetObject(
+            bucketName,
+            objectName,
+            buffer,
+            bufferSize,
+            [promise](GetObjectResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::GetObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        char* buffer,
+        size_t bufferSize,
+        GetObjectDelegate onCompletion
+    ) {
+        const auto amountPlaced = std::make_shared< size_t >(0);
+        GetObject(
+            bucketName,
+            objectName,
+            [buffer, bufferSize, amountPlaced](const char* data, size_t size){
+                if (size > bufferSize - *amountPlaced) {
+                    return false;
                 }
-                return result;
+                (void)memcpy(buffer + *amountPlaced, data, size);
+                *amountPlaced += size;
+                return true;
+            },
+            onCompletion,
+            bufferSize
+        );
+    }
+
+    auto S3::GetObjectRange(
+        const std::string& bucketName,
+        const std::string& objectName,
+        size_t offset,
+        size_t length
+    ) -> std::future< GetObjectResult > {
+        const auto promise = std::make_shared< std::promise< GetObjectResult > >();
+        auto future = promise->get_future();
+        GetObjectRange(
+            bucketName,
+            objectName,
+            offset,
+            length,
+            [promise](GetObjectResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::GetObjectRange(
+        const std::string& bucketName,
+        const std::string& objectName,
+        size_t offset,
+        size_t length,
+        GetObjectDelegate onCompletion
+    ) {
+        auto impl(impl_);
+        length = std::max(length, (size_t)1);
+        impl->Post(
+            [impl, bucketName, objectName, offset, length, onCompletion]{
+                impl->GetObjectRange(bucketName, objectName, offset, length, onCompletion);
+            }
+        );
+    }
+
+    auto S3::DownloadObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        ContentWriter contentWriter,
+        size_t partSize,
+        size_t maxPartsInFlight
+    ) -> std::future< GetObjectResult > {
+        const auto promise = std::make_shared< std::promise< GetObjectResult > >();
+        auto future = promise->get_future();
+        DownloadObject(
+            bucketName,
+            objectName,
+            contentWriter,
+            [promise](GetObjectResult result){
+                promise->set_value(std::move(result));
+            },
+            partSize,
+            maxPartsInFlight
+        );
+        return future;
+    }
+
+    void S3::DownloadObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        ContentWriter contentWriter,
+        GetObjectDelegate onCompletion,
+        size_t partSize,
+        size_t maxPartsInFlight
+    ) {
+        auto impl(impl_);
+        const auto download = std::make_shared< Impl::Download >();
+        download->bucketName = bucketName;
+        download->objectName = objectName;
+        download->contentWriter = contentWriter;
+        download->partSize = std::max(partSize, (size_t)1);
+        download->maxPartsInFlight = std::max(maxPartsInFlight, (size_t)1);
+        download->nextOffset = download->partSize;
+        download->partsInFlight = 1;
+        download->onCompletion = onCompletion;
+        impl->Post(
+            [impl, download]{
+                impl->DownloadPart(download, 0);
             }
         );
     }
 
+    auto S3::DownloadObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        char* buffer,
+        size_t bufferSize,
+        size_t partSize,
+        size_t maxPartsInFlight
+    ) -> std::future< GetObjectResult > {
+        const auto promise = std::make_shared< std::promise< GetObjectResult > >();
+        auto future = promise->get_future();
+        DownloadObject(
+            bucketName,
+            objectName,
+            buffer,
+            bufferSize,
+            [promise](GetObjectResult result){
+                promise->set_value(std::move(result));
+            },
+            partSize,
+            maxPartsInFlight
+        );
+        return future;
+    }
+
+    void S3::DownloadObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        char* buffer,
+        size_t bufferSize,
+        GetObjectDelegate onCompletion,
+        size_t partSize,
+        size_t maxPartsInFlight
+    ) {
+        DownloadObject(
+            bucketName,
+            objectName,
+            [buffer, bufferSize](size_t offset, const char* data, size_t size){
+                if (
+                    (offset > bufferSize)
+                    || (size > bufferSize - offset)
+                ) {
+                    return false;
+                }
+                (void)memcpy(buffer + offset, data, size);
+                return true;
+            },
+            onCompletion,
+            partSize,
+            maxPartsInFlight
+        );
+    }
+
     auto S3::PutObject(
         const std::string& bucketName,
         const std::string& objectName,
         const std::string& contents,
-        const std::map< std::string, std::string > extraHeaders
+        const std::map< std::string, std::string > extraHeaders,
+        PayloadSigning payloadSigning
     ) -> std::future< PutObjectResult > {
+        const auto promise = std::make_shared< std::promise< PutObjectResult > >();
+        auto future = promise->get_future();
+        PutObject(
+            bucketName,
+            objectName,
+            contents,
+            [promise](PutObjectResult result){
+                promise->set_value(std::move(result));
+            },
+            extraHeaders,
+            payloadSigning
+        );
+        return future;
+    }
+
+    void S3::PutObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        const std::string& contents,
+        PutObjectDelegate onCompletion,
+        const std::map< std::string, std::string > extraHeaders,
+        PayloadSigning payloadSigning
+    ) {
+        PutObject(
+            bucketName,
+            objectName,
+            std::string(contents),
+            onCompletion,
+            extraHeaders,
+            payloadSigning
+        );
+    }
+
+    void S3::PutObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        std::string&& contents,
+        PutObjectDelegate onCompletion,
+        const std::map< std::string, std::string > extraHeaders,
+        PayloadSigning payloadSigning
+    ) {
         auto impl(impl_);
-        return std::async(
-            std::launch::async,
-            [impl, bucketName, objectName, contents, extraHeaders]{
-                PutObjectResult result;
-                const auto host = "s3." + impl->config.region + ".amazonaws.com";
-                const auto date = AmzTimestamp(time(NULL));
-                Http::Request request;
-                request.method = "PUT";
-                request.target.SetHost(host);
-                request.target.SetPort(443);
-                auto objectNameParts = Split(objectName, '/');
-                objectNameParts.insert(objectNameParts.begin(), {"", bucketName});
-                request.target.SetPath(objectNameParts);
-                request.headers.AddHeader("Host", host);
-                request.headers.AddHeader("x-amz-date", date);
-                for (const auto& extraHeader: extraHeaders) {
-                    request.headers.AddHeader(extraHeader.first, extraHeader.second);
-                }
-                request.headers.SetHeader(
-                    "Content-Length",
-                    StringExtensions::sprintf("%zu", contents.length())
-                );
-                request.body = contents;
-                const auto canonicalRequest = SignApi::ConstructCanonicalRequest(request.Generate());
-                const auto payloadHashOffset = canonicalRequest.find_last_of('\n') + 1;
-                const auto payloadHash = canonicalRequest.substr(payloadHashOffset);
-                const auto stringToSign = SignApi::MakeStringToSign(
-                    impl->config.region,
-                    "s3",
-                    canonicalRequest
-                );
-                const auto authorization = SignApi::MakeAuthorization(
-                    stringToSign,
-                    canonicalRequest,
-                    impl->config.accessKeyId,
-                    impl->config.secretAccessKey
+        impl->Post(
+            std::bind(
+                [impl, bucketName, objectName, onCompletion, extraHeaders, payloadSigning](std::string& contents){
+                    std::string payloadHash;
+                    if (payloadSigning == PayloadSigning::Signed) {
+                        payloadHash = IncrementalSha256::HashAsHex(contents);
+                    }
+                    impl->PutObject(
+                        bucketName,
+                        objectName,
+                        std::move(contents),
+                        payloadHash,
+                        extraHeaders,
+                        payloadSigning,
+                        onCompletion
+                    );
+                },
+                std::move(contents)
+            )
+        );
+    }
+
+    auto S3::PutObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        ContentSource contentSource,
+        const std::map< std::string, std::string > extraHeaders,
+        size_t contentLength,
+        PayloadSigning payloadSigning
+    ) -> std::future< PutObjectResult > {
+        const auto promise = std::make_shared< std::promise< PutObjectResult > >();
+        auto future = promise->get_future();
+        PutObject(
+            bucketName,
+            objectName,
+            contentSource,
+            [promise](PutObjectResult result){
+                promise->set_value(std::move(result));
+            },
+            extraHeaders,
+            contentLength,
+            payloadSigning
+        );
+        return future;
+    }
+
+    void S3::PutObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        ContentSource contentSource,
+        PutObjectDelegate onCompletion,
+        const std::map< std::string, std::string > extraHeaders,
+        size_t contentLength,
+        PayloadSigning payloadSigning
+    ) {
+        auto impl(impl_);
+        impl->Post(
+            [impl, bucketName, objectName, contentSource, onCompletion, extraHeaders, contentLength, payloadSigning]{
+                if (
+                    (payloadSigning == PayloadSigning::Streaming)
+                    && (contentLength > 0)
+                ) {
+                    impl->PutObjectStreaming(
+                        bucketName,
+                        objectName,
+                        contentSource,
+                        contentLength,
+                        extraHeaders,
+                        onCompletion
+                    );
+                    return;
+                }
+                // Read through a fixed chunk buffer, so that the contents
+                // never grow past the space reserved for them when the
+                // length is known up front.
+                std::string contents;
+                contents.reserve(contentLength);
+                IncrementalSha256 payloadHash;
+                std::vector< char > chunk(CHUNK_SIZE);
+                for (;;) {
+                    const auto amountRead = contentSource(chunk.data(), chunk.size());
+                    if (amountRead == 0) {
+                        break;
+                    }
+                    contents.append(chunk.data(), amountRead);
+                    if (payloadSigning == PayloadSigning::Signed) {
+                        payloadHash.Append(chunk.data(), amountRead);
+                    }
+                }
+                impl->PutObject(
+                    bucketName,
+                    objectName,
+                    std::move(contents),
+                    (
+                        (payloadSigning == PayloadSigning::Signed)
+                        ? payloadHash.FinishAsHex()
+                        : ""
+                    ),
+                    extraHeaders,
+                    payloadSigning,
+                    onCompletion
                 );
-                request.headers.AddHeader("Authorization", authorization);
-                request.headers.AddHeader("x-amz-content-sha256", payloadHash);
-                if (!impl->config.sessionToken.empty()) {
-                    request.headers.AddHeader("x-amz-security-token", impl->config.sessionToken);
-                }
-                const auto rawRequest = request.Generate();
-                const auto transaction = impl->http->Request(request);
-                transaction->AwaitCompletion();
-                result.transactionState = transaction->state;
-                result.statusCode = transaction->response.statusCode;
-                result.headers = transaction->response.headers;
-                if (transaction->state == Http::IClient::Transaction::State::Completed) {
-                    if (transaction->response.statusCode != 200) {
-                        result.errorInfo = XmlToJson(
-                            transaction->response.body,
-                            std::set< std::string >({})
+            }
+        );
+    }
+
+    auto S3::CreateMultipartUpload(
+        const std::string& bucketName,
+        const std::string& objectName,
+        const std::map< std::string, std::string > extraHeaders
+    ) -> std::future< CreateMultipartUploadResult > {
+        const auto promise = std::make_shared< std::promise< CreateMultipartUploadResult > >();
+        auto future = promise->get_future();
+        CreateMultipartUpload(
+            bucketName,
+            objectName,
+            [promise](CreateMultipartUploadResult result){
+                promise->set_value(std::move(result));
+            },
+            extraHeaders
+        );
+        return future;
+    }
+
+    void S3::CreateMultipartUpload(
+        const std::string& bucketName,
+        const std::string& objectName,
+        CreateMultipartUploadDelegate onCompletion,
+        const std::map< std::string, std::string > extraHeaders
+    ) {
+        auto impl(impl_);
+        impl->Post(
+            [impl, bucketName, objectName, onCompletion, extraHeaders]{
+                impl->CreateMultipartUpload(bucketName, objectName, extraHeaders, onCompletion);
+            }
+        );
+    }
+
+    auto S3::UploadPart(
+        const std::string& bucketName,
+        const std::string& objectName,
+        const std::string& uploadId,
+        unsigned int partNumber,
+        const std::string& contents
+    ) -> std::future< UploadPartResult > {
+        const auto promise = std::make_shared< std::promise< UploadPartResult > >();
+        auto future = promise->get_future();
+        UploadPart(
+            bucketName,
+            objectName,
+            uploadId,
+            partNumber,
+            contents,
+            [promise](UploadPartResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::UploadPart(
+        const std::string& bucketName,
+        const std::string& objectName,
+        const std::string& uploadId,
+        unsigned int partNumber,
+        const std::string& contents,
+        UploadPartDelegate onCompletion
+    ) {
+        auto impl(impl_);
+        impl->Post(
+            std::bind(
+                [impl, bucketName, objectName, uploadId, partNumber, onCompletion](std::string& contents){
+                    impl->UploadPart(bucketName, objectName, uploadId, partNumber, std::move(contents), onCompletion);
+                },
+                std::string(contents)
+            )
+        );
+    }
+
+    auto S3::CompleteMultipartUpload(
+        const std::string& bucketName,
+        const std::string& objectName,
+        const std::string& uploadId,
+        const std::vector< CompletedPart >& parts
+    ) -> std::future< CompleteMultipartUploadResult > {
+        const auto promise = std::make_shared< std::promise< CompleteMultipartUploadResult > >();
+        auto future = promise->get_future();
+        CompleteMultipartUpload(
+            bucketName,
+            objectName,
+            uploadId,
+            parts,
+            [promise](CompleteMultipartUploadResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::CompleteMultipartUpload(
+        const std::string& bucketName,
+        const std::string& objectName,
+        const std::string& uploadId,
+        const std::vector< CompletedPart >& parts,
+        CompleteMultipartUploadDelegate onCompletion
+    ) {
+        auto impl(impl_);
+        impl->Post(
+            [impl, bucketName, objectName, uploadId, parts, onCompletion]{
+                impl->CompleteMultipartUpload(bucketName, objectName, uploadId, parts, onCompletion);
+            }
+        );
+    }
+
+    auto S3::AbortMultipartUpload(
+        const std::string& bucketName,
+        const std::string& objectName,
+        const std::string& uploadId
+    ) -> std::future< AbortMultipartUploadResult > {
+        const auto promise = std::make_shared< std::promise< AbortMultipartUploadResult > >();
+        auto future = promise->get_future();
+        AbortMultipartUpload(
+            bucketName,
+            objectName,
+            uploadId,
+            [promise](AbortMultipartUploadResult result){
+                promise->set_value(std::move(result));
+            }
+        );
+        return future;
+    }
+
+    void S3::AbortMultipartUpload(
+        const std::string& bucketName,
+        const std::string& objectName,
+        const std::string& uploadId,
+        AbortMultipartUploadDelegate onCompletion
+    ) {
+        auto impl(impl_);
+        impl->Post(
+            [impl, bucketName, objectName, uploadId, onCompletion]{
+                impl->AbortMultipartUpload(bucketName, objectName, uploadId, onCompletion);
+            }
+        );
+    }
+
+    auto S3::UploadObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        ContentSource contentSource,
+        const std::map< std::string, std::string > extraHeaders,
+        size_t partSize,
+        size_t maxPartsInFlight,
+        size_t maxAttemptsPerPart
+    ) -> std::future< CompleteMultipartUploadResult > {
+        const auto promise = std::make_shared< std::promise< CompleteMultipartUploadResult > >();
+        auto future = promise->get_future();
+        UploadObject(
+            bucketName,
+            objectName,
+            contentSource,
+            [promise](CompleteMultipartUploadResult result){
+                promise->set_value(std::move(result));
+            },
+            extraHeaders,
+            partSize,
+            maxPartsInFlight,
+            maxAttemptsPerPart
+        );
+        return future;
+    }
+
+    void S3::UploadObject(
+        const std::string& bucketName,
+        const std::string& objectName,
+        ContentSource contentSource,
+        CompleteMultipartUploadDelegate onCompletion,
+        const std::map< std::string, std::string > extraHeaders,
+        size_t partSize,
+        size_t maxPartsInFlight,
+        size_t maxAttemptsPerPart
+    ) {
+        auto impl(impl_);
+        const auto upload = std::make_shared< Impl::Upload >();
+        upload->bucketName = bucketName;
+        upload->objectName = objectName;
+        upload->contentSource = contentSource;
+        upload->partSize = (size_t)std::min(
+            (uint64_t)std::max(partSize, MIN_UPLOAD_PART_SIZE),
+            MAX_UPLOAD_PART_SIZE
+        );
+        upload->maxPartsInFlight = std::max(maxPartsInFlight, (size_t)1);
+        upload->maxAttemptsPerPart = std::max(maxAttemptsPerPart, (size_t)1);
+        upload->onCompletion = onCompletion;
+        impl->Post(
+            [impl, upload, extraHeaders]{
+                impl->CreateMultipartUpload(
+                    upload->bucketName,
+                    upload->objectName,
+                    extraHeaders,
+                    [impl, upload](CreateMultipartUploadResult result){
+                        if (
+                            (result.transactionState != Http::IClient::Transaction::State::Completed)
+                            || (result.statusCode != 200)
+                        ) {
+                            upload->result.transactionState = result.transactionState;
+                            upload->result.statusCode = result.statusCode;
+                            upload->result.headers = std::move(result.headers);
+                            upload->result.errorInfo = std::move(result.errorInfo);
+                            upload->onCompletion(std::move(upload->result));
+                            return;
+                        }
+                        upload->uploadId = result.uploadId;
+                        impl->Post(
+                            [impl, upload]{
+                                impl->PumpUpload(upload);
+                            }
                         );
                     }
-                }
-                return result;
+                );
             }
         );
     }
@@ -0,0 +1,203 @@
+/**
+ * @file S3MetricsAggregator.cpp
+ *
+ * This module contains the implementation of the Aws::S3MetricsAggregator
+ * class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <atomic>
+#include <Aws/S3MetricsAggregator.hpp>
+#include <chrono>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace {
+
+    /**
+     * This is the number of different kinds of requests made of S3.
+     */
+    constexpr size_t NUM_OPERATIONS = (size_t)Aws::S3::Operation::AbortMultipartUpload + 1;
+
+    /**
+     * This holds the statistics gathered about one kind of request, as
+     * they're being gathered.
+     */
+    struct OperationCounters {
+        std::atomic< uint64_t > requests;
+        std::atomic< uint64_t > transactionFailures;
+        std::atomic< uint64_t > clientErrors;
+        std::atomic< uint64_t > serverErrors;
+        std::atomic< uint64_t > retries;
+        std::atomic< uint64_t > bytesSent;
+        std::atomic< uint64_t > bytesReceived;
+        std::atomic< uint64_t > latencyCounts[Aws::S3MetricsAggregator::LatencyHistogram::NUM_BUCKETS];
+    };
+
+}
+
+namespace Aws {
+
+    constexpr size_t S3MetricsAggregator::LatencyHistogram::SUB_BUCKET_BITS;
+    constexpr size_t S3MetricsAggregator::LatencyHistogram::NUM_BUCKETS;
+
+    size_t S3MetricsAggregator::LatencyHistogram::GetBucketIndex(uint64_t nanoseconds) {
+        if (nanoseconds < (1 << SUB_BUCKET_BITS)) {
+            return (size_t)nanoseconds;
+        }
+        size_t mostSignificantBit = 0;
+        for (size_t shift = 32; shift > 0; shift >>= 1) {
+            if ((nanoseconds >> (mostSignificantBit + shift)) != 0) {
+                mostSignificantBit += shift;
+            }
+        }
+        const auto shift = mostSignificantBit - SUB_BUCKET_BITS;
+        return (
+            ((shift + 1) << SUB_BUCKET_BITS)
+            + (size_t)(nanoseconds >> shift)
+            - (1 << SUB_BUCKET_BITS)
+        );
+    }
+
+    uint64_t S3MetricsAggregator::LatencyHistogram::GetBucketLowerBound(size_t index) {
+        if (index < (1 << SUB_BUCKET_BITS)) {
+            return (uint64_t)index;
+        }
+        const auto shift = (index >> SUB_BUCKET_BITS) - 1;
+        const auto subBucket = index & ((1 << SUB_BUCKET_BITS) - 1);
+        return ((uint64_t)((1 << SUB_BUCKET_BITS) + subBucket) << shift);
+    }
+
+    uint64_t S3MetricsAggregator::LatencyHistogram::GetBucketUpperBound(size_t index) {
+        if (index + 1 >= NUM_BUCKETS) {
+            return UINT64_MAX;
+        }
+        return GetBucketLowerBound(index + 1) - 1;
+    }
+
+    uint64_t S3MetricsAggregator::LatencyHistogram::GetCount() const {
+        uint64_t count = 0;
+        for (const auto bucketCount: counts) {
+            count += bucketCount;
+        }
+        return count;
+    }
+
+    std::chrono::nanoseconds S3MetricsAggregator::LatencyHistogram::GetPercentile(double percentile) const {
+        const auto count = GetCount();
+        if (count == 0) {
+            return std::chrono::nanoseconds::zero();
+        }
+        auto rank = (uint64_t)ceil(percentile / 100.0 * (double)count);
+        if (rank < 1) {
+            rank = 1;
+        } else if (rank > count) {
+            rank = count;
+        }
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                const auto upperBound = GetBucketUpperBound(i);
+                return std::chrono::nanoseconds(
+                    (upperBound > (uint64_t)INT64_MAX)
+                    ? INT64_MAX
+                    : (int64_t)upperBound
+                );
+            }
+        }
+        return std::chrono::nanoseconds::zero();
+    }
+
+    /**
+     * This contains the private properties of an S3MetricsAggregator
+     * instance.
+     */
+    struct S3MetricsAggregator::Impl {
+        /**
+         * These are the statistics gathered about each kind of request,
+         * indexed by the kind of request.
+         */
+        OperationCounters operations[NUM_OPERATIONS];
+    };
+
+    S3MetricsAggregator::~S3MetricsAggregator() noexcept = default;
+    S3MetricsAggregator::S3MetricsAggregator(S3MetricsAggregator&& other) noexcept = default;
+    S3MetricsAggregator& S3MetricsAggregator::operator=(S3MetricsAggregator&& other) noexcept = default;
+
+    S3MetricsAggregator::S3MetricsAggregator()
+        : impl_(new Impl)
+    {
+        Reset();
+    }
+
+    auto S3MetricsAggregator::GetSnapshot() const -> Snapshot {
+        Snapshot snapshot;
+        for (size_t i = 0; i < NUM_OPERATIONS; ++i) {
+            const auto& counters = impl_->operations[i];
+            const auto requests = counters.requests.load(std::memory_order_relaxed);
+            if (requests == 0) {
+                continue;
+            }
+            auto& statistics = snapshot[(S3::Operation)i];
+            statistics.requests = requests;
+            statistics.transactionFailures = counters.transactionFailures.load(std::memory_order_relaxed);
+            statistics.clientErrors = counters.clientErrors.load(std::memory_order_relaxed);
+            statistics.serverErrors = counters.serverErrors.load(std::memory_order_relaxed);
+            statistics.retries = counters.retries.load(std::memory_order_relaxed);
+            statistics.bytesSent = counters.bytesSent.load(std::memory_order_relaxed);
+            statistics.bytesReceived = counters.bytesReceived.load(std::memory_order_relaxed);
+            for (size_t j = 0; j < LatencyHistogram::NUM_BUCKETS; ++j) {
+                statistics.latency.counts[j] = counters.latencyCounts[j].load(std::memory_order_relaxed);
+            }
+        }
+        return snapshot;
+    }
+
+    void S3MetricsAggregator::Reset() {
+        for (auto& counters: impl_->operations) {
+            counters.requests.store(0, std::memory_order_relaxed);
+            counters.transactionFailures.store(0, std::memory_order_relaxed);
+            counters.clientErrors.store(0, std::memory_order_relaxed);
+            counters.serverErrors.store(0, std::memory_order_relaxed);
+            counters.retries.store(0, std::memory_order_relaxed);
+            counters.bytesSent.store(0, std::memory_order_relaxed);
+            counters.bytesReceived.store(0, std::memory_order_relaxed);
+            for (auto& latencyCount: counters.latencyCounts) {
+                latencyCount.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void S3MetricsAggregator::RequestCompleted(const S3::RequestMetrics& metrics) {
+        const auto operation = (size_t)metrics.operation;
+        if (operation >= NUM_OPERATIONS) {
+            return;
+        }
+        auto& counters = impl_->operations[operation];
+        if (metrics.transactionState != Http::IClient::Transaction::State::Completed) {
+            counters.transactionFailures.fetch_add(1, std::memory_order_relaxed);
+        } else if (
+            (metrics.statusCode >= 400)
+            && (metrics.statusCode < 500)
+        ) {
+            counters.clientErrors.fetch_add(1, std::memory_order_relaxed);
+        } else if (
+            (metrics.statusCode >= 500)
+            && (metrics.statusCode < 600)
+        ) {
+            counters.serverErrors.fetch_add(1, std::memory_order_relaxed);
+        }
+        counters.retries.fetch_add(metrics.retries, std::memory_order_relaxed);
+        counters.bytesSent.fetch_add(metrics.bytesSent, std::memory_order_relaxed);
+        counters.bytesReceived.fetch_add(metrics.bytesReceived, std::memory_order_relaxed);
+        const auto duration = metrics.duration.count();
+        counters.latencyCounts[
+            LatencyHistogram::GetBucketIndex((duration < 0) ? 0 : (uint64_t)duration)
+        ].fetch_add(1, std::memory_order_relaxed);
+        counters.requests.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}
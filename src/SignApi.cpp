@@ -6,17 +6,19 @@
  * © 2018 by Richard Walters
  */
 
+#include "IncrementalSha256.hpp"
+
 #include <algorithm>
 #include <Aws/SignApi.hpp>
 #include <Hash/Hmac.hpp>
 #include <Hash/Sha2.hpp>
 #include <Hash/Templates.hpp>
 #include <Http/Server.hpp>
-#include <map>
 #include <MessageHeaders/MessageHeaders.hpp>
-#include <sstream>
+#include <stdint.h>
 #include <string>
 #include <StringExtensions/StringExtensions.hpp>
+#include <Uri/Uri.hpp>
 #include <vector>
 
 namespace {
@@ -28,37 +30,140 @@ namespace {
     static const char* const HASH_ALGORITHM = "AWS4-HMAC-SHA256";
 
     /**
-     * Breaks the given string at each instance of the given delimiter,
-     * returning the pieces as a collection of substrings.  The delimiter
-     * characters are removed.
+     * This is the string defined by Amazon which terminates the credential
+     * scope and is the last input used in deriving a signing key.
+     */
+    static const char TERMINATION_STRING[] = "aws4_request";
+
+    /**
+     * This is the identifier defined by Amazon for the algorithm used to
+     * sign the individual chunks of a payload sent in chunks.
+     */
+    static const char* const CHUNK_HASH_ALGORITHM = "AWS4-HMAC-SHA256-PAYLOAD";
+
+    /**
+     * This is the hex-encoded SHA-256 hash of an empty string.
+     */
+    static const char* const EMPTY_STRING_HASH = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+
+    /**
+     * This identifies a piece of a string by its position and length,
+     * so that it can be referred to without making a copy of it.
+     */
+    struct Slice {
+        /**
+         * This is the position of the first character of the piece.
+         */
+        size_t offset;
+
+        /**
+         * This is the number of characters in the piece.
+         */
+        size_t length;
+    };
+
+    /**
+     * This holds the location of the name and value of one parameter
+     * in the query of a request.
+     */
+    struct Parameter {
+        /**
+         * This is the location of the parameter name in the query.
+         */
+        Slice name;
+
+        /**
+         * This is the location of the parameter value in the query.
+         */
+        Slice value;
+    };
+
+    /**
+     * This holds the location of the name (converted to lower case)
+     * of one header of a request, along with the index of the header
+     * in the original list of headers.
+     */
+    struct HeaderEntry {
+        /**
+         * This is the location of the lower-case header name within the
+         * string where lower-case header names are collected.
+         */
+        Slice name;
+
+        /**
+         * This is the index of the header in the original list of headers.
+         */
+        size_t index;
+    };
+
+    /**
+     * This holds working storage used while constructing canonical
+     * requests.  One of these is kept for each thread, so that once it
+     * has grown large enough, constructing canonical requests doesn't
+     * require any further memory allocations for these things.
+     */
+    struct CanonicalizerWorkspace {
+        /**
+         * This holds a copy of the request's path segments.
+         */
+        std::vector< std::string > path;
+
+        /**
+         * This holds a copy of the request's query.
+         */
+        std::string query;
+
+        /**
+         * This holds the locations of the parameters in the query.
+         */
+        std::vector< Parameter > parameters;
+
+        /**
+         * This holds a copy of the request's headers.
+         */
+        MessageHeaders::MessageHeaders::Headers headers;
+
+        /**
+         * This holds the names of the request's headers, converted to
+         * lower case, one after another.
+         */
+        std::string headerNames;
+
+        /**
+         * This holds the locations of the names of the request's headers.
+         */
+        std::vector< HeaderEntry > headerEntries;
+    };
+
+    /**
+     * This is the working storage used on the current thread to construct
+     * canonical requests.
+     */
+    thread_local CanonicalizerWorkspace workspace;
+
+    /**
+     * Lexicographically compare the two given pieces of the given string.
      *
      * @param[in] s
-     *     This is the string to split.
+     *     This is the string containing the pieces to compare.
      *
-     * @param[in] d
-     *     This is the delimiter character at which to split the string.
+     * @param[in] lhs
+     *     This is the location of the first piece to compare.
+     *
+     * @param[in] rhs
+     *     This is the location of the second piece to compare.
      *
      * @return
-     *     The collection of substrings that result from breaking the given
-     *     string at each delimiter character is returned.
+     *     A negative number is returned if the first piece comes before
+     *     the second piece, a positive number if it comes after, and
+     *     zero if the two pieces are equal.
      */
-    std::vector< std::string > Split(
+    int CompareSlices(
         const std::string& s,
-        char d
+        const Slice& lhs,
+        const Slice& rhs
     ) {
-        std::vector< std::string > values;
-        auto remainder = s;
-        while (!remainder.empty()) {
-            auto delimiter = remainder.find_first_of(d);
-            if (delimiter == std::string::npos) {
-                values.push_back(remainder);
-                remainder.clear();
-            } else {
-                values.push_back(remainder.substr(0, delimiter));
-                remainder = remainder.substr(delimiter + 1);
-            }
-        }
-        return values;
+        return s.compare(lhs.offset, lhs.length, s, rhs.offset, rhs.length);
     }
 
     /**
@@ -79,6 +184,58 @@ namespace {
         }
     }
 
+    /**
+     * Determine whether or not the given character is in the "unreserved"
+     * set defined in RFC 3986.
+     *
+     * @param[in] c
+     *     This is the character to check.
+     *
+     * @return
+     *     An indication of whether or not the given character is in the
+     *     "unreserved" set is returned.
+     */
+    bool IsUnreserved(uint8_t c) {
+        return (
+            ((c >= 'A') && (c <= 'Z'))
+            || ((c >= 'a') && (c <= 'z'))
+            || ((c >= '0') && (c <= '9'))
+            || (c == '-')
+            || (c == '_')
+            || (c == '.')
+            || (c == '~')
+        );
+    }
+
+    /**
+     * Determine whether or not the given character may appear in a path
+     * segment of a URI without being percent-encoded, according to the
+     * "pchar" rule of RFC 3986.
+     *
+     * @param[in] c
+     *     This is the character to check.
+     *
+     * @return
+     *     An indication of whether or not the given character may appear
+     *     in a path segment without being percent-encoded is returned.
+     */
+    bool IsPathCharacter(uint8_t c) {
+        if (IsUnreserved(c)) {
+            return true;
+        }
+        switch (c) {
+            case '!': case '$': case '&': case '\'': case '(': case ')':
+            case '*': case '+': case ',': case ';': case '=': case ':':
+            case '@': {
+                return true;
+            }
+
+            default: {
+                return false;
+            }
+        }
+    }
+
     /**
      * Encode the given string according to Amazon's strange notion of
      * what it means to "URI Encode" something (pretty much the same as
@@ -87,63 +244,393 @@ namespace {
      * is *(pchar / "/" / "?").  But heck, who reads Internet standards
      * these days, eh?
      *
+     * @param[in,out] output
+     *     This is the string to which to append the encoded string.
+     *
      * @param[in] s
-     *     This is the string to encode.
+     *     This is the string containing the piece to encode.
+     *
+     * @param[in] slice
+     *     This is the location of the piece of the string to encode.
+     */
+    void AppendAmzUriEncoded(
+        std::string& output,
+        const std::string& s,
+        const Slice& slice
+    ) {
+        for (size_t i = slice.offset; i < slice.offset + slice.length; ++i) {
+            const auto c = (uint8_t)s[i];
+            if (IsUnreserved(c)) {
+                output.push_back((char)c);
+            } else {
+                output.push_back('%');
+                output.push_back(MakeHexDigit((unsigned int)c >> 4));
+                output.push_back(MakeHexDigit((unsigned int)c & 0x0F));
+            }
+        }
+    }
+
+    /**
+     * Return the value of the given hex digit, or -1 if the given
+     * character isn't a hex digit.
+     *
+     * @param[in] c
+     *     This is the character to convert.
      *
      * @return
-     *     The output of the Amazon brand of "URI Encode" applied
-     *     to the given string is returned.
+     *     The value of the given hex digit is returned, or -1 if the
+     *     given character isn't a hex digit.
      */
-    std::string AmzUriEncode(const std::string& s) {
-        std::string output;
-        for (uint8_t c: s) {
+    int DecodeHexDigit(char c) {
+        if ((c >= '0') && (c <= '9')) {
+            return c - '0';
+        } else if ((c >= 'A') && (c <= 'F')) {
+            return c - 'A' + 10;
+        } else if ((c >= 'a') && (c <= 'f')) {
+            return c - 'a' + 10;
+        } else {
+            return -1;
+        }
+    }
+
+    /**
+     * Encode the given piece of a query in the Amazon brand of "URI
+     * Encode", like AppendAmzUriEncoded, except that any percent-encoded
+     * characters in the piece are first decoded, so that they're encoded
+     * the way S3 encodes them when it checks the signature, rather than
+     * being encoded a second time.
+     *
+     * @param[in,out] output
+     *     This is the string to which to append the encoded string.
+     *
+     * @param[in] s
+     *     This is the string containing the piece to encode.
+     *
+     * @param[in] slice
+     *     This is the location of the piece of the string to encode.
+     */
+    void AppendAmzUriReencoded(
+        std::string& output,
+        const std::string& s,
+        const Slice& slice
+    ) {
+        const auto end = slice.offset + slice.length;
+        for (size_t i = slice.offset; i < end; ++i) {
+            auto c = (uint8_t)s[i];
             if (
-                ((c >= 'A') && (c <= 'Z'))
-                || ((c >= 'a') && (c <= 'z'))
-                || ((c >= '0') && (c <= '9'))
-                || (c == '-')
-                || (c == '_')
-                || (c == '.')
-                || (c == '~')
+                (c == '%')
+                && (i + 2 < end)
+                && (DecodeHexDigit(s[i + 1]) >= 0)
+                && (DecodeHexDigit(s[i + 2]) >= 0)
             ) {
-                output.push_back(c);
+                c = (uint8_t)((DecodeHexDigit(s[i + 1]) << 4) + DecodeHexDigit(s[i + 2]));
+                i += 2;
+            }
+            if (IsUnreserved(c)) {
+                output.push_back((char)c);
             } else {
                 output.push_back('%');
                 output.push_back(MakeHexDigit((unsigned int)c >> 4));
                 output.push_back(MakeHexDigit((unsigned int)c & 0x0F));
             }
         }
-        return output;
     }
 
     /**
-     * This function replaces sequences of two or more spaces with a single
-     * space, to meet the requirement of header values in canonical API
-     * requests, that multiple spaces should be replaced by a single space.
+     * This function appends the given string, with leading and trailing
+     * whitespace removed and sequences of two or more spaces replaced by a
+     * single space, to meet the requirement of header values in canonical
+     * API requests, that values should be trimmed and multiple spaces
+     * should be replaced by a single space.
+     *
+     * @param[in,out] output
+     *     This is the string to which to append the given string.
      *
      * @param[in] s
      *     This is the string for which to replace multiple spaces with a
      *     single space.
-     *
-     * @return
-     *     The given string, with multiple spaces replaced by a single space,
-     *     is returned.
      */
-    std::string CanonicalizeSpaces(const std::string& s) {
-        std::ostringstream output;
+    void AppendCanonicalizedSpaces(
+        std::string& output,
+        const std::string& s
+    ) {
+        static const char* const WHITESPACE = " \t\r\n";
+        const auto begin = s.find_first_not_of(WHITESPACE);
+        if (begin == std::string::npos) {
+            return;
+        }
+        const auto end = s.find_last_not_of(WHITESPACE) + 1;
         bool lastCharWasSpace = false;
-        for (const auto& c: s) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto c = s[i];
             if (c == ' ') {
                 if (!lastCharWasSpace) {
                     lastCharWasSpace = true;
-                    output << ' ';
+                    output.push_back(' ');
                 }
             } else {
-                output << c;
+                output.push_back(c);
                 lastCharWasSpace = false;
             }
         }
-        return output.str();
+    }
+
+    /**
+     * Append the canonical form of the given request path to the given
+     * string.
+     *
+     * Paths which are already in normal form and contain no characters
+     * that need to be percent-encoded (the usual case) are appended
+     * directly.  Any other path is normalized and encoded by the Uri
+     * library, to produce exactly the same result it always has.
+     *
+     * @param[in,out] output
+     *     This is the string to which to append the canonical path.
+     *
+     * @param[in] path
+     *     This is the path to canonicalize, as a sequence of segments.
+     */
+    void AppendCanonicalPath(
+        std::string& output,
+        const std::vector< std::string >& path
+    ) {
+        bool simple = !path.empty();
+        for (size_t i = 0; simple && (i < path.size()); ++i) {
+            const auto& segment = path[i];
+            if (
+                (segment == ".")
+                || (segment == "..")
+                || (
+                    (i > 0)
+                    && segment.empty()
+                    && path[i - 1].empty()
+                )
+            ) {
+                simple = false;
+                break;
+            }
+            for (auto c: segment) {
+                if (!IsPathCharacter((uint8_t)c)) {
+                    simple = false;
+                    break;
+                }
+            }
+        }
+        if (!simple) {
+            Uri::Uri requestPath;
+            requestPath.SetPath(path);
+            requestPath.NormalizePath();
+            output += requestPath.GenerateString();
+            return;
+        }
+        if (
+            (path.size() == 1)
+            && path[0].empty()
+        ) {
+            output.push_back('/');
+            return;
+        }
+        bool first = true;
+        for (const auto& segment: path) {
+            if (first) {
+                first = false;
+            } else {
+                output.push_back('/');
+            }
+            output += segment;
+        }
+    }
+
+    /**
+     * This function appends the credential scope for the given date,
+     * region, and service to the given string.
+     *
+     * @param[in,out] output
+     *     This is the string to which to append the credential scope.
+     *
+     * @param[in] date
+     *     This is the date part (YYYYMMDD) of the credential scope.
+     *
+     * @param[in] region
+     *     This is the region part of the credential scope.
+     *
+     * @param[in] service
+     *     This is the service part of the credential scope.
+     */
+    void AppendCredentialScope(
+        std::string& output,
+        const std::string& date,
+        const std::string& region,
+        const std::string& service
+    ) {
+        output += date;
+        output.push_back('/');
+        output += region;
+        output.push_back('/');
+        output += service;
+        output.push_back('/');
+        output += TERMINATION_STRING;
+    }
+
+    /**
+     * This function extracts the credential scope (the third line)
+     * from the given string to sign.
+     *
+     * @param[in] stringToSign
+     *     This is the string to sign from which to extract the credential
+     *     scope.
+     *
+     * @return
+     *     The credential scope is returned.
+     */
+    std::string GetCredentialScope(const std::string& stringToSign) {
+        auto lineStart = stringToSign.find('\n');
+        if (lineStart != std::string::npos) {
+            lineStart = stringToSign.find('\n', lineStart + 1);
+        }
+        if (lineStart == std::string::npos) {
+            return "";
+        }
+        ++lineStart;
+        const auto lineEnd = stringToSign.find('\n', lineStart);
+        return stringToSign.substr(
+            lineStart,
+            (lineEnd == std::string::npos) ? std::string::npos : lineEnd - lineStart
+        );
+    }
+
+    /**
+     * This function extracts the list of signed headers (the next to last
+     * line) from the given canonical request.
+     *
+     * @param[in] canonicalRequest
+     *     This is the canonical request from which to extract the list of
+     *     signed headers.
+     *
+     * @return
+     *     The list of signed headers is returned.
+     */
+    std::string GetSignedHeaders(const std::string& canonicalRequest) {
+        const auto lineEnd = canonicalRequest.find_last_of('\n');
+        if (
+            (lineEnd == std::string::npos)
+            || (lineEnd == 0)
+        ) {
+            return "";
+        }
+        const auto previousLineEnd = canonicalRequest.find_last_of('\n', lineEnd - 1);
+        const auto lineStart = (
+            (previousLineEnd == std::string::npos)
+            ? 0
+            : previousLineEnd + 1
+        );
+        return canonicalRequest.substr(lineStart, lineEnd - lineStart);
+    }
+
+    /**
+     * This function signs the given string to sign using the given
+     * signing key.
+     *
+     * @param[in] signingKey
+     *     This is the key derived for the credential scope of the request.
+     *
+     * @param[in] stringToSign
+     *     This is the string to sign.
+     *
+     * @return
+     *     The signature, as a string of lower-case hexadecimal digits,
+     *     is returned.
+     */
+    std::string MakeSignature(
+        const std::vector< uint8_t >& signingKey,
+        const std::string& stringToSign
+    ) {
+        const auto hmacBytesToHexString = Hash::MakeHmacBytesToStringFunction(
+            Hash::BytesToString< Hash::Sha256 >,
+            Hash::SHA256_BLOCK_SIZE
+        );
+        return hmacBytesToHexString(
+            signingKey,
+            std::vector< uint8_t >(stringToSign.begin(), stringToSign.end())
+        );
+    }
+
+    /**
+     * This function constucts the authorization header value for an
+     * AWS API request from the given access key ID, credential scope,
+     * list of signed headers, and signature.
+     *
+     * @param[in] accessKeyId
+     *     This is the ID of the key used to sign the request.
+     *
+     * @param[in] credentialScope
+     *     This is the credential scope of the request.
+     *
+     * @param[in] signedHeaders
+     *     This is the list of headers included in the signature.
+     *
+     * @param[in] signature
+     *     This is the signature of the request.
+     *
+     * @return
+     *     The authorization value is returned.
+     */
+    std::string MakeAuthorizationFromSignature(
+        const std::string& accessKeyId,
+        const std::string& credentialScope,
+        const std::string& signedHeaders,
+        const std::string& signature
+    ) {
+        std::string output;
+        output += HASH_ALGORITHM;
+        output += " Credential=";
+        output += accessKeyId;
+        output.push_back('/');
+        output += credentialScope;
+        output += ", SignedHeaders=";
+        output += signedHeaders;
+        output += ", Signature=";
+        output += signature;
+        return output;
+    }
+
+    /**
+     * This function constucts the authorization header value for an
+     * AWS API request, using the given access key ID, credential scope,
+     * and signing key to sign the given string to sign.
+     *
+     * @param[in] stringToSign
+     *     This is the string to sign in order to make the signature
+     *     included in the authorization.
+     *
+     * @param[in] signedHeaders
+     *     This is the list of headers included in the signature.
+     *
+     * @param[in] accessKeyId
+     *     This is the ID of the key to use to sign the request.
+     *
+     * @param[in] credentialScope
+     *     This is the credential scope of the request.
+     *
+     * @param[in] signingKey
+     *     This is the key derived for the credential scope of the request.
+     *
+     * @return
+     *     The authorization value is returned.
+     */
+    std::string MakeAuthorizationWithSigningKey(
+        const std::string& stringToSign,
+        const std::string& signedHeaders,
+        const std::string& accessKeyId,
+        const std::string& credentialScope,
+        const std::vector< uint8_t >& signingKey
+    ) {
+        return MakeAuthorizationFromSignature(
+            accessKeyId,
+            credentialScope,
+            signedHeaders,
+            MakeSignature(signingKey, stringToSign)
+        );
     }
 
 }
@@ -156,121 +643,192 @@ namespace Aws {
         if (request == nullptr) {
            return "";
         }
-        std::ostringstream canonicalRequest;
+        return ConstructCanonicalRequest(*request).text;
+    }
+
+    auto SignApi::ConstructCanonicalRequest(const Http::Request& request) -> CanonicalRequest {
+        CanonicalRequest canonicalRequest;
+        ConstructCanonicalRequest(request, canonicalRequest);
+        return canonicalRequest;
+    }
+
+    void SignApi::ConstructCanonicalRequest(
+        const Http::Request& request,
+        CanonicalRequest& canonicalRequest
+    ) {
+        auto& text = canonicalRequest.text;
+        auto& signedHeaders = canonicalRequest.signedHeaders;
+        text.clear();
+        signedHeaders.clear();
+        canonicalRequest.dateTime.clear();
 
         // The following steps should match those shown here:
         // https://docs.aws.amazon.com/general/latest/gr/sigv4-create-canonical-request.html
 
         // Step 1
-        canonicalRequest << request->method << "\n";
+        text += request.method;
+        text.push_back('\n');
 
         // Step 2
-        Uri::Uri requestPath;
-        requestPath.SetPath(request->target.GetPath());
-        requestPath.NormalizePath();
-        canonicalRequest << requestPath.GenerateString() << "\n";
+        workspace.path = request.target.GetPath();
+        AppendCanonicalPath(text, workspace.path);
+        text.push_back('\n');
 
         // Step 3
-        if (request->target.HasQuery()) {
-            const auto requestQuery = request->target.GetQuery();
-            const auto parametersString = Split(requestQuery, '&');
-            struct Parameter {
-                std::string name;
-                std::string value;
-            };
-            std::vector< Parameter > parametersVector;
-            for (const auto& parameter: parametersString) {
-                const auto delimiter = parameter.find('=');
-                if (delimiter == std::string::npos) {
-                    parametersVector.push_back({parameter, ""});
+        if (request.target.HasQuery()) {
+            auto& query = workspace.query;
+            auto& parameters = workspace.parameters;
+            query = request.target.GetQuery();
+            parameters.clear();
+            size_t offset = 0;
+            while (offset < query.length()) {
+                auto end = query.find('&', offset);
+                if (end == std::string::npos) {
+                    end = query.length();
+                }
+                Parameter parameter;
+                const auto delimiter = query.find('=', offset);
+                if (
+                    (delimiter == std::string::npos)
+                    || (delimiter > end)
+                ) {
+                    parameter.name = {offset, end - offset};
+                    parameter.value = {end, 0};
                 } else {
-                    parametersVector.push_back({
-                        parameter.substr(0, delimiter),
-                        parameter.substr(delimiter + 1)
-                    });
+                    parameter.name = {offset, delimiter - offset};
+                    parameter.value = {delimiter + 1, end - delimiter - 1};
                 }
+                parameters.push_back(parameter);
+                offset = end + 1;
             }
             std::sort(
-                parametersVector.begin(),
-                parametersVector.end(),
-                [](
+                parameters.begin(),
+                parameters.end(),
+                [&query](
                     const Parameter& lhs,
                     const Parameter& rhs
                 ) {
-                    if (lhs.name < rhs.name) {
-                        return true;
-                    } else if (lhs.name > rhs.name) {
-                        return false;
-                    } else {
-                        return lhs.value < rhs.value;
+                    const auto nameComparison = CompareSlices(query, lhs.name, rhs.name);
+                    if (nameComparison != 0) {
+                        return (nameComparison < 0);
                     }
+                    return (CompareSlices(query, lhs.value, rhs.value) < 0);
                 }
             );
             bool first = true;
-            for (const auto& parameter: parametersVector) {
+            for (const auto& parameter: parameters) {
                 if (first) {
                     first = false;
                 } else {
-                    canonicalRequest << '&';
+                    text.push_back('&');
                 }
-                canonicalRequest << AmzUriEncode(parameter.name) << '=' << AmzUriEncode(parameter.value);
+                AppendAmzUriReencoded(text, query, parameter.name);
+                text.push_back('=');
+                AppendAmzUriReencoded(text, query, parameter.value);
             }
         }
-        canonicalRequest << "\n";
+        text.push_back('\n');
 
         // Step 4
-        std::map<
-            std::string,
-            std::vector< std::string >
-        > headersByName;
-        for (const auto& header: request->headers.GetAll()) {
-            auto& headerValues = headersByName[StringExtensions::ToLower(header.name)];
-            headerValues.push_back(CanonicalizeSpaces(header.value));
-        }
-        struct Header {
-            std::string name;
-            std::vector< std::string > values;
-        };
-        std::vector< Header > headersVector;
-        headersVector.reserve(headersByName.size());
-        for (auto& header: headersByName) {
-            headersVector.push_back({
-                header.first,
-                header.second
-            });
+        auto& headers = workspace.headers;
+        auto& headerNames = workspace.headerNames;
+        auto& headerEntries = workspace.headerEntries;
+        headers = request.headers.GetAll();
+        headerNames.clear();
+        headerEntries.clear();
+        for (size_t i = 0; i < headers.size(); ++i) {
+            const std::string& name = headers[i].name;
+            HeaderEntry headerEntry;
+            headerEntry.name = {headerNames.length(), name.length()};
+            headerEntry.index = i;
+            for (auto c: name) {
+                if ((c >= 'A') && (c <= 'Z')) {
+                    headerNames.push_back((char)(c - 'A' + 'a'));
+                } else {
+                    headerNames.push_back(c);
+                }
+            }
+            headerEntries.push_back(headerEntry);
         }
         std::sort(
-            headersVector.begin(),
-            headersVector.end(),
-            [](
-                const Header& lhs,
-                const Header& rhs
+            headerEntries.begin(),
+            headerEntries.end(),
+            [&headerNames](
+                const HeaderEntry& lhs,
+                const HeaderEntry& rhs
             ) {
-                return (lhs.name < rhs.name);
+                const auto nameComparison = CompareSlices(headerNames, lhs.name, rhs.name);
+                if (nameComparison != 0) {
+                    return (nameComparison < 0);
+                }
+                return (lhs.index < rhs.index);
             }
         );
-        for (const auto& header: headersVector) {
-            canonicalRequest << header.name << ':' << StringExtensions::Join(header.values, ",") << "\n";
-        }
-        canonicalRequest << "\n";
-
-        // Step 5
-        bool first = true;
-        for (const auto& header: headersVector) {
-            if (first) {
-                first = false;
+        static const std::string dateHeaderName = "x-amz-date";
+        static const std::string contentHashHeaderName = "x-amz-content-sha256";
+        size_t valueOffset = 0;
+        bool isDateHeader = false;
+        bool isContentHashHeader = false;
+        bool hasContentHashHeader = false;
+        for (size_t i = 0; i < headerEntries.size(); ++i) {
+            const auto& headerEntry = headerEntries[i];
+            const auto sameNameAsPrevious = (
+                (i > 0)
+                && (CompareSlices(headerNames, headerEntries[i - 1].name, headerEntry.name) == 0)
+            );
+            if (sameNameAsPrevious) {
+                text.push_back(',');
             } else {
-                canonicalRequest << ';';
+                if (i > 0) {
+                    text.push_back('\n');
+                    signedHeaders.push_back(';');
+                }
+                text.append(headerNames, headerEntry.name.offset, headerEntry.name.length);
+                text.push_back(':');
+                signedHeaders.append(headerNames, headerEntry.name.offset, headerEntry.name.length);
+                valueOffset = text.length();
+                isDateHeader = (
+                    headerNames.compare(
+                        headerEntry.name.offset,
+                        headerEntry.name.length,
+                        dateHeaderName
+                    ) == 0
+                );
+                isContentHashHeader = (
+                    headerNames.compare(
+                        headerEntry.name.offset,
+                        headerEntry.name.length,
+                        contentHashHeaderName
+                    ) == 0
+                );
+            }
+            AppendCanonicalizedSpaces(text, headers[headerEntry.index].value);
+            if (isDateHeader) {
+                canonicalRequest.dateTime.assign(text, valueOffset, std::string::npos);
+            }
+            if (isContentHashHeader) {
+                canonicalRequest.payloadHash.assign(text, valueOffset, std::string::npos);
+                hasContentHashHeader = true;
             }
-            canonicalRequest << header.name;
         }
-        canonicalRequest << "\n";
+        if (!headerEntries.empty()) {
+            text.push_back('\n');
+        }
+        text.push_back('\n');
 
-        // Step 6
-        canonicalRequest << Hash::StringToString< Hash::Sha256 >(request->body);
+        // Step 5
+        text += signedHeaders;
+        text.push_back('\n');
 
-        // Done.  Return constructed request.
-        return canonicalRequest.str();
+        // Step 6
+        //
+        // If the payload hash was already provided in the request (which is
+        // required by S3), it's used as-is, so that the body doesn't need to
+        // be hashed a second time (or be present at all).
+        if (!hasContentHashHeader) {
+            canonicalRequest.payloadHash = IncrementalSha256::HashAsHex(request.body);
+        }
+        text += canonicalRequest.payloadHash;
     }
 
     std::string SignApi::MakeStringToSign(
@@ -278,20 +836,26 @@ namespace Aws {
         const std::string& service,
         const std::string& canonicalRequest
     ) {
-        std::ostringstream output;
+        static const std::string dateHeaderPrefix = "\nx-amz-date:";
         std::string dateTime;
-        for (const auto& line: StringExtensions::Split(canonicalRequest, '\n')) {
-            if (line.substr(0, 11) == "x-amz-date:") {
-                dateTime = line.substr(11);
-                break;
-            }
+        const auto dateHeaderOffset = canonicalRequest.find(dateHeaderPrefix);
+        if (dateHeaderOffset != std::string::npos) {
+            const auto dateTimeOffset = dateHeaderOffset + dateHeaderPrefix.length();
+            const auto lineEnd = canonicalRequest.find('\n', dateTimeOffset);
+            dateTime = canonicalRequest.substr(
+                dateTimeOffset,
+                (lineEnd == std::string::npos) ? std::string::npos : lineEnd - dateTimeOffset
+            );
         }
-        output
-            << HASH_ALGORITHM << "\n"
-            << dateTime << "\n"
-            << dateTime.substr(0, 8) << "/" << region << "/" << service << "/aws4_request\n"
-            << Hash::StringToString< Hash::Sha256 >(canonicalRequest);
-        return output.str();
+        std::string output;
+        output += HASH_ALGORITHM;
+        output.push_back('\n');
+        output += dateTime;
+        output.push_back('\n');
+        AppendCredentialScope(output, dateTime.substr(0, 8), region, service);
+        output.push_back('\n');
+        output += IncrementalSha256::HashAsHex(canonicalRequest);
+        return output;
     }
 
     std::string SignApi::MakeAuthorization(
@@ -300,13 +864,171 @@ namespace Aws {
         const std::string& accessKeyId,
         const std::string& accessKeySecret
     ) {
-        std::ostringstream output;
-        const auto credentialScope = StringExtensions::Split(stringToSign, '\n')[2];
+        const auto credentialScope = GetCredentialScope(stringToSign);
         const auto credentialScopeParts = StringExtensions::Split(credentialScope, '/');
-        const auto date = credentialScopeParts[0];
-        const auto region = credentialScopeParts[1];
-        const auto service = credentialScopeParts[2];
-        const auto terminationString = credentialScopeParts[3];
+        return MakeAuthorizationWithSigningKey(
+            stringToSign,
+            GetSignedHeaders(canonicalRequest),
+            accessKeyId,
+            credentialScope,
+            MakeSigningKey(
+                accessKeySecret,
+                credentialScopeParts[0],
+                credentialScopeParts[1],
+                credentialScopeParts[2]
+            )
+        );
+    }
+
+    std::string SignApi::MakeAuthorization(
+        const std::string& stringToSign,
+        const std::string& canonicalRequest,
+        const std::string& accessKeyId,
+        const std::string& accessKeySecret,
+        SigningKeyCache& signingKeyCache
+    ) {
+        const auto credentialScope = GetCredentialScope(stringToSign);
+        const auto credentialScopeParts = StringExtensions::Split(credentialScope, '/');
+        return MakeAuthorizationWithSigningKey(
+            stringToSign,
+            GetSignedHeaders(canonicalRequest),
+            accessKeyId,
+            credentialScope,
+            signingKeyCache.GetSigningKey(
+                accessKeySecret,
+                credentialScopeParts[0],
+                credentialScopeParts[1],
+                credentialScopeParts[2]
+            )
+        );
+    }
+
+    void SignApi::MakeStringToSign(
+        const std::string& region,
+        const std::string& service,
+        const CanonicalRequest& canonicalRequest,
+        StringToSign& stringToSign
+    ) {
+        stringToSign.date.assign(canonicalRequest.dateTime, 0, 8);
+        stringToSign.region = region;
+        stringToSign.service = service;
+        stringToSign.credentialScope.clear();
+        AppendCredentialScope(stringToSign.credentialScope, stringToSign.date, region, service);
+        auto& text = stringToSign.text;
+        text.clear();
+        text += HASH_ALGORITHM;
+        text.push_back('\n');
+        text += canonicalRequest.dateTime;
+        text.push_back('\n');
+        text += stringToSign.credentialScope;
+        text.push_back('\n');
+        text += IncrementalSha256::HashAsHex(canonicalRequest.text);
+    }
+
+    std::string SignApi::MakeAuthorization(
+        const CanonicalRequest& canonicalRequest,
+        const StringToSign& stringToSign,
+        const std::string& accessKeyId,
+        const std::string& accessKeySecret,
+        SigningKeyCache& signingKeyCache
+    ) {
+        return MakeAuthorizationWithSigningKey(
+            stringToSign.text,
+            canonicalRequest.signedHeaders,
+            accessKeyId,
+            stringToSign.credentialScope,
+            signingKeyCache.GetSigningKey(
+                accessKeySecret,
+                stringToSign.date,
+                stringToSign.region,
+                stringToSign.service
+            )
+        );
+    }
+
+    void SignApi::SignRequest(
+        const Http::Request& request,
+        const std::string& region,
+        const std::string& service,
+        const std::string& accessKeyId,
+        const std::string& accessKeySecret,
+        SigningKeyCache& signingKeyCache,
+        RequestSignature& signature
+    ) {
+        ConstructCanonicalRequest(request, signature.canonicalRequest);
+        SignCanonicalRequest(
+            region,
+            service,
+            accessKeyId,
+            accessKeySecret,
+            signingKeyCache,
+            signature
+        );
+    }
+
+    void SignApi::SignCanonicalRequest(
+        const std::string& region,
+        const std::string& service,
+        const std::string& accessKeyId,
+        const std::string& accessKeySecret,
+        SigningKeyCache& signingKeyCache,
+        RequestSignature& signature
+    ) {
+        MakeStringToSign(region, service, signature.canonicalRequest, signature.stringToSign);
+        signature.signature = MakeSignature(
+            signingKeyCache.GetSigningKey(
+                accessKeySecret,
+                signature.stringToSign.date,
+                region,
+                service
+            ),
+            signature.stringToSign.text
+        );
+        signature.authorization = MakeAuthorizationFromSignature(
+            accessKeyId,
+            signature.stringToSign.credentialScope,
+            signature.canonicalRequest.signedHeaders,
+            signature.signature
+        );
+    }
+
+    std::string SignApi::MakeChunkSignature(
+        const RequestSignature& requestSignature,
+        const std::string& previousSignature,
+        const std::string& chunkHash,
+        const std::string& accessKeySecret,
+        SigningKeyCache& signingKeyCache
+    ) {
+        const auto& stringToSign = requestSignature.stringToSign;
+        std::string chunkStringToSign;
+        chunkStringToSign += CHUNK_HASH_ALGORITHM;
+        chunkStringToSign.push_back('\n');
+        chunkStringToSign += requestSignature.canonicalRequest.dateTime;
+        chunkStringToSign.push_back('\n');
+        chunkStringToSign += stringToSign.credentialScope;
+        chunkStringToSign.push_back('\n');
+        chunkStringToSign += previousSignature;
+        chunkStringToSign.push_back('\n');
+        chunkStringToSign += EMPTY_STRING_HASH;
+        chunkStringToSign.push_back('\n');
+        chunkStringToSign += chunkHash;
+        return MakeSignature(
+            signingKeyCache.GetSigningKey(
+                accessKeySecret,
+                stringToSign.date,
+                stringToSign.region,
+                stringToSign.service
+            ),
+            chunkStringToSign
+        );
+    }
+
+    std::vector< uint8_t > SignApi::MakeSigningKey(
+        const std::string& accessKeySecret,
+        const std::string& date,
+        const std::string& region,
+        const std::string& service
+    ) {
         const auto hmacRawStringToBytes = Hash::MakeHmacStringToBytesFunction(
             Hash::StringToBytes< Hash::Sha256 >,
             Hash::SHA256_BLOCK_SIZE
@@ -315,11 +1037,7 @@ namespace Aws {
             Hash::Sha256,
             Hash::SHA256_BLOCK_SIZE
         );
-        const auto hmacBytesToHexString = Hash::MakeHmacBytesToStringFunction(
-            Hash::BytesToString< Hash::Sha256 >,
-            Hash::SHA256_BLOCK_SIZE
-        );
-        const auto signingKey = hmacBytesToBytes(
+        return hmacBytesToBytes(
             hmacBytesToBytes(
                 hmacBytesToBytes(
                     hmacRawStringToBytes(
@@ -330,20 +1048,17 @@ namespace Aws {
                 ),
                 std::vector< uint8_t >(service.begin(), service.end())
             ),
-            std::vector< uint8_t >(terminationString.begin(), terminationString.end())
-        );
-        const auto signature = hmacBytesToHexString(
-            signingKey,
-            std::vector< uint8_t >(stringToSign.begin(), stringToSign.end())
+            std::vector< uint8_t >(
+                TERMINATION_STRING,
+                TERMINATION_STRING + sizeof(TERMINATION_STRING) - 1
+            )
         );
-        const auto canonicalRequestLines = StringExtensions::Split(canonicalRequest, '\n');
-        const auto signedHeaders = canonicalRequestLines[canonicalRequestLines.size() - 2];
-        output
-            << HASH_ALGORITHM
-            << " Credential=" << accessKeyId << "/" << credentialScope
-            << ", SignedHeaders=" << signedHeaders
-            << ", Signature=" << signature;
-        return output.str();
+    }
+
+    std::string SignApi::AmzUriEncode(const std::string& s) {
+        std::string encoded;
+        AppendAmzUriEncoded(encoded, s, {0, s.length()});
+        return encoded;
     }
 
 }
@@ -0,0 +1,128 @@
+/**
+ * @file SigningKeyCache.cpp
+ *
+ * This module contains the implementation of the Aws::SigningKeyCache class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <algorithm>
+#include <Aws/SignApi.hpp>
+#include <Aws/SigningKeyCache.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * This holds a signing key along with the access key secret and
+     * credential scope from which it was derived.
+     */
+    struct Entry {
+        /**
+         * This is the secret value of the key from which the signing key
+         * was derived.
+         */
+        std::string accessKeySecret;
+
+        /**
+         * This is the date part (YYYYMMDD) of the credential scope.
+         */
+        std::string date;
+
+        /**
+         * This is the region part of the credential scope.
+         */
+        std::string region;
+
+        /**
+         * This is the service part of the credential scope.
+         */
+        std::string service;
+
+        /**
+         * This is the signing key derived for the credential scope.
+         */
+        std::vector< uint8_t > signingKey;
+    };
+
+}
+
+namespace Aws {
+
+    /**
+     * This contains the private properties of a SigningKeyCache instance.
+     */
+    struct SigningKeyCache::Impl {
+        /**
+         * This is used to synchronize access to the object.
+         */
+        std::mutex mutex;
+
+        /**
+         * These are the signing keys currently remembered.  There are
+         * expected to be only a handful of them at any given time, so
+         * they're kept in a simple collection which can be searched without
+         * making any copies of the search terms.
+         */
+        std::vector< Entry > entries;
+    };
+
+    SigningKeyCache::~SigningKeyCache() noexcept = default;
+    SigningKeyCache::SigningKeyCache(SigningKeyCache&& other) noexcept = default;
+    SigningKeyCache& SigningKeyCache::operator=(SigningKeyCache&& other) noexcept = default;
+
+    SigningKeyCache::SigningKeyCache()
+        : impl_(new Impl)
+    {
+    }
+
+    std::vector< uint8_t > SigningKeyCache::GetSigningKey(
+        const std::string& accessKeySecret,
+        const std::string& date,
+        const std::string& region,
+        const std::string& service
+    ) {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        for (const auto& entry: impl_->entries) {
+            if (
+                (entry.date == date)
+                && (entry.region == region)
+                && (entry.service == service)
+                && (entry.accessKeySecret == accessKeySecret)
+            ) {
+                return entry.signingKey;
+            }
+        }
+        impl_->entries.erase(
+            std::remove_if(
+                impl_->entries.begin(),
+                impl_->entries.end(),
+                [&date](const Entry& entry) {
+                    return (entry.date < date);
+                }
+            ),
+            impl_->entries.end()
+        );
+        Entry entry;
+        entry.accessKeySecret = accessKeySecret;
+        entry.date = date;
+        entry.region = region;
+        entry.service = service;
+        entry.signingKey = SignApi::MakeSigningKey(accessKeySecret, date, region, service);
+        impl_->entries.push_back(entry);
+        return entry.signingKey;
+    }
+
+    size_t SigningKeyCache::GetSize() const {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return impl_->entries.size();
+    }
+
+    void SigningKeyCache::Clear() {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->entries.clear();
+    }
+
+}
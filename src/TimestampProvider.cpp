@@ -0,0 +1,189 @@
+/**
+ * @file TimestampProvider.cpp
+ *
+ * This module contains the implementation of the Aws::TimestampProvider
+ * class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <atomic>
+#include <Aws/TimestampProvider.hpp>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <string.h>
+#include <time.h>
+
+namespace {
+
+    /**
+     * This is the number of characters in a timestamp in the format
+     * YYYYMMDD'T'HHMMSS'Z'.
+     */
+    constexpr size_t TIMESTAMP_LENGTH = 16;
+
+    /**
+     * Write the given number into the given buffer as the given number of
+     * decimal digits, with leading zeroes.
+     *
+     * @param[out] buffer
+     *     This is where to write the digits.
+     *
+     * @param[in] value
+     *     This is the number to write.
+     *
+     * @param[in] numDigits
+     *     This is the number of digits to write.
+     */
+    void WriteDigits(char* buffer, int64_t value, size_t numDigits) {
+        for (size_t i = numDigits; i > 0; --i) {
+            buffer[i - 1] = (char)('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    /**
+     * Convert the given time from seconds since the UNIX epoch to the
+     * ISO-8601 format YYYYMMDD'T'HHMMSS'Z' expected by AWS.
+     *
+     * The day number is converted to a date using the "civil from days"
+     * algorithm by Howard Hinnant, so no calendar functions from the C
+     * library (which may not be thread-safe) are used.
+     *
+     * @param[in] time
+     *     This is the time in seconds since the UNIX epoch.
+     *
+     * @param[out] buffer
+     *     This is where to write the formatted time.
+     */
+    void WriteTimestamp(int64_t time, char (&buffer)[TIMESTAMP_LENGTH]) {
+        auto days = time / 86400;
+        auto secondsOfDay = time % 86400;
+        if (secondsOfDay < 0) {
+            secondsOfDay += 86400;
+            --days;
+        }
+        days += 719468;
+        const auto era = ((days >= 0) ? days : (days - 146096)) / 146097;
+        const auto dayOfEra = days - era * 146097;
+        const auto yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const auto dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const auto monthIndex = (5 * dayOfYear + 2) / 153;
+        const auto day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+        const auto month = ((monthIndex < 10) ? (monthIndex + 3) : (monthIndex - 9));
+        const auto year = yearOfEra + era * 400 + ((month <= 2) ? 1 : 0);
+        WriteDigits(buffer, year, 4);
+        WriteDigits(buffer + 4, month, 2);
+        WriteDigits(buffer + 6, day, 2);
+        buffer[8] = 'T';
+        WriteDigits(buffer + 9, secondsOfDay / 3600, 2);
+        WriteDigits(buffer + 11, secondsOfDay / 60 % 60, 2);
+        WriteDigits(buffer + 13, secondsOfDay % 60, 2);
+        buffer[15] = 'Z';
+    }
+
+}
+
+namespace Aws {
+
+    /**
+     * This contains the private properties of a TimestampProvider instance.
+     *
+     * The remembered time and its formatted form are guarded by a sequence
+     * number, which is odd while they're being updated, and which changes
+     * whenever they're updated.  Readers check that the sequence number is
+     * even and didn't change while they copied the remembered time, and
+     * otherwise format the time themselves, so they never wait.  Everything
+     * shared is atomic, so there are no data races.
+     */
+    struct TimestampProvider::Impl {
+        /**
+         * This is the function to call to get the current time.
+         */
+        Clock clock;
+
+        /**
+         * This is odd while the remembered time is being updated, and
+         * changes whenever it's updated.
+         */
+        std::atomic< uint32_t > sequence{0};
+
+        /**
+         * This is the time most recently formatted, in seconds since the
+         * UNIX epoch.
+         */
+        std::atomic< int64_t > cachedTime{INT64_MIN};
+
+        /**
+         * These hold the characters of the formatted form of the time most
+         * recently formatted.
+         */
+        std::atomic< uint64_t > cachedText[TIMESTAMP_LENGTH / sizeof(uint64_t)];
+    };
+
+    TimestampProvider::~TimestampProvider() noexcept = default;
+    TimestampProvider::TimestampProvider(TimestampProvider&& other) noexcept = default;
+    TimestampProvider& TimestampProvider::operator=(TimestampProvider&& other) noexcept = default;
+
+    TimestampProvider::TimestampProvider()
+        : TimestampProvider([]{ return time(NULL); })
+    {
+    }
+
+    TimestampProvider::TimestampProvider(Clock clock)
+        : impl_(new Impl)
+    {
+        impl_->clock = clock;
+        for (auto& word: impl_->cachedText) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::string TimestampProvider::GetTimestamp() {
+        const auto now = (int64_t)impl_->clock();
+        auto sequence = impl_->sequence.load(std::memory_order_acquire);
+        const auto cachedTime = impl_->cachedTime.load(std::memory_order_relaxed);
+        uint64_t text[TIMESTAMP_LENGTH / sizeof(uint64_t)];
+        if (
+            ((sequence & 1) == 0)
+            && (cachedTime == now)
+        ) {
+            for (size_t i = 0; i < TIMESTAMP_LENGTH / sizeof(uint64_t); ++i) {
+                text[i] = impl_->cachedText[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (impl_->sequence.load(std::memory_order_relaxed) == sequence) {
+                return std::string((const char*)text, TIMESTAMP_LENGTH);
+            }
+        }
+        char buffer[TIMESTAMP_LENGTH];
+        WriteTimestamp(now, buffer);
+        if (
+            ((sequence & 1) == 0)
+            && (cachedTime < now)
+            && impl_->sequence.compare_exchange_strong(
+                sequence,
+                sequence + 1,
+                std::memory_order_acquire,
+                std::memory_order_relaxed
+            )
+        ) {
+            std::atomic_thread_fence(std::memory_order_release);
+            (void)memcpy(text, buffer, TIMESTAMP_LENGTH);
+            impl_->cachedTime.store(now, std::memory_order_relaxed);
+            for (size_t i = 0; i < TIMESTAMP_LENGTH / sizeof(uint64_t); ++i) {
+                impl_->cachedText[i].store(text[i], std::memory_order_relaxed);
+            }
+            impl_->sequence.store(sequence + 2, std::memory_order_release);
+        }
+        return std::string(buffer, TIMESTAMP_LENGTH);
+    }
+
+    std::string TimestampProvider::FormatTimestamp(time_t time) {
+        char buffer[TIMESTAMP_LENGTH];
+        WriteTimestamp((int64_t)time, buffer);
+        return std::string(buffer, TIMESTAMP_LENGTH);
+    }
+
+}
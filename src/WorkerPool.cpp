@@ -0,0 +1,188 @@
+/**
+ * @file WorkerPool.cpp
+ *
+ * This module contains the implementation of the Aws::WorkerPool class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <algorithm>
+#include <Aws/WorkerPool.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Aws {
+
+    /**
+     * This contains the private properties of a WorkerPool instance.
+     *
+     * The workers share ownership of these properties, so that a worker
+     * can safely finish up even if the pool is destroyed by one of its
+     * own tasks.
+     */
+    struct WorkerPool::Impl {
+        /**
+         * This is used to synchronize access to the object.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used by workers to wait for tasks to be posted, or for
+         * the pool to be stopped.
+         */
+        std::condition_variable wakeCondition;
+
+        /**
+         * These are the tasks waiting to be run.
+         */
+        std::deque< std::function< void() > > tasks;
+
+        /**
+         * These are the tasks which were posted with a delay and aren't
+         * yet due to run, keyed by when they become due.
+         */
+        std::multimap<
+            std::chrono::steady_clock::time_point,
+            std::function< void() >
+        > delayedTasks;
+
+        /**
+         * This indicates whether or not the workers should exit once
+         * no more tasks are waiting.
+         */
+        bool stop = false;
+
+        /**
+         * These are the worker threads.
+         */
+        std::vector< std::thread > workers;
+
+        /**
+         * This is the body of each worker thread.
+         *
+         * @param[in] self
+         *     This is a reference to the pool properties, held by the
+         *     worker to keep them alive until it exits.
+         */
+        static void Worker(std::shared_ptr< Impl > self) {
+            std::unique_lock< decltype(self->mutex) > lock(self->mutex);
+            for (;;) {
+                // Queue any delayed tasks which are now due, or all of
+                // them if the pool is stopping.
+                const auto now = std::chrono::steady_clock::now();
+                while (
+                    !self->delayedTasks.empty()
+                    && (
+                        self->stop
+                        || (self->delayedTasks.begin()->first <= now)
+                    )
+                ) {
+                    self->tasks.push_back(std::move(self->delayedTasks.begin()->second));
+                    (void)self->delayedTasks.erase(self->delayedTasks.begin());
+                }
+                if (self->tasks.empty()) {
+                    if (self->stop) {
+                        break;
+                    }
+                    if (self->delayedTasks.empty()) {
+                        self->wakeCondition.wait(lock);
+                    } else {
+                        (void)self->wakeCondition.wait_until(
+                            lock,
+                            self->delayedTasks.begin()->first
+                        );
+                    }
+                    continue;
+                }
+                auto task = std::move(self->tasks.front());
+                self->tasks.pop_front();
+                lock.unlock();
+                task();
+                task = nullptr;
+                lock.lock();
+            }
+        }
+    };
+
+    WorkerPool::~WorkerPool() noexcept {
+        if (impl_ == nullptr) {
+            return;
+        }
+        std::vector< std::thread > workers;
+        {
+            std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+            impl_->stop = true;
+            workers.swap(impl_->workers);
+        }
+        impl_->wakeCondition.notify_all();
+        for (auto& worker: workers) {
+            if (worker.get_id() == std::this_thread::get_id()) {
+                worker.detach();
+            } else {
+                worker.join();
+            }
+        }
+    }
+    WorkerPool::WorkerPool(WorkerPool&& other) noexcept = default;
+    WorkerPool& WorkerPool::operator=(WorkerPool&& other) noexcept {
+        if (this != &other) {
+            WorkerPool oldWorkerPool(std::move(*this));
+            impl_ = std::move(other.impl_);
+        }
+        return *this;
+    }
+
+    WorkerPool::WorkerPool(size_t numWorkers)
+        : impl_(std::make_shared< Impl >())
+    {
+        numWorkers = std::max(numWorkers, (size_t)1);
+        impl_->workers.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i) {
+            impl_->workers.emplace_back(&Impl::Worker, impl_);
+        }
+    }
+
+    void WorkerPool::Post(std::function< void() > task) {
+        // The task may destroy the pool before this method returns,
+        // so hold onto the pool properties until then.
+        const auto impl = impl_;
+        {
+            std::lock_guard< decltype(impl->mutex) > lock(impl->mutex);
+            impl->tasks.push_back(std::move(task));
+        }
+        impl->wakeCondition.notify_one();
+    }
+
+    void WorkerPool::PostDelayed(
+        std::function< void() > task,
+        std::chrono::milliseconds delay
+    ) {
+        // The task may destroy the pool before this method returns,
+        // so hold onto the pool properties until then.
+        const auto impl = impl_;
+        {
+            std::lock_guard< decltype(impl->mutex) > lock(impl->mutex);
+            (void)impl->delayedTasks.emplace(
+                std::chrono::steady_clock::now() + delay,
+                std::move(task)
+            );
+        }
+
+        // Every waiting worker is woken, since any of them may be waiting
+        // for a later delayed task than this one.
+        impl->wakeCondition.notify_all();
+    }
+
+    size_t WorkerPool::GetSize() const {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return impl_->workers.size();
+    }
+
+}
@@ -0,0 +1,530 @@
+/**
+ * @file XmlParser.cpp
+ *
+ * This module contains the implementation of the Aws::XmlParser class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include "XmlParser.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <string.h>
+
+namespace {
+
+    /**
+     * Determine whether or not the given character is XML whitespace.
+     *
+     * @param[in] c
+     *     This is the character to check.
+     *
+     * @return
+     *     An indication of whether or not the given character is XML
+     *     whitespace is returned.
+     */
+    bool IsWhitespace(char c) {
+        return (
+            (c == ' ')
+            || (c == '\t')
+            || (c == '\r')
+            || (c == '\n')
+        );
+    }
+
+    /**
+     * Find the first occurrence of the given string in the given text.
+     *
+     * @param[in] text
+     *     This points to the text to search.
+     *
+     * @param[in] length
+     *     This is the number of characters of text to search.
+     *
+     * @param[in] target
+     *     This is the string to find.
+     *
+     * @return
+     *     A pointer to the first occurrence of the string in the text
+     *     is returned, or nullptr if the string isn't found.
+     */
+    const char* Find(const char* text, size_t length, const char* target) {
+        const auto targetLength = strlen(target);
+        while (length >= targetLength) {
+            const auto next = (const char*)memchr(text, target[0], length - targetLength + 1);
+            if (next == nullptr) {
+                break;
+            }
+            if (memcmp(next, target, targetLength) == 0) {
+                return next;
+            }
+            length -= (size_t)(next - text) + 1;
+            text = next + 1;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Find the end of the tag which begins at the given text, skipping
+     * over any quoted attribute values, which may contain ">" characters.
+     *
+     * @param[in] tag
+     *     This points to the text beginning with the tag.
+     *
+     * @param[in] length
+     *     This is the number of characters of text.
+     *
+     * @return
+     *     A pointer to the ">" character which ends the tag is returned,
+     *     or nullptr if the end of the tag isn't found.
+     */
+    const char* FindTagEnd(const char* tag, size_t length) {
+        const auto end = tag + length;
+        while (tag < end) {
+            const auto c = *tag;
+            if (c == '>') {
+                return tag;
+            }
+            if (
+                (c == '"')
+                || (c == '\'')
+            ) {
+                tag = (const char*)memchr(tag + 1, c, (size_t)(end - tag - 1));
+                if (tag == nullptr) {
+                    return nullptr;
+                }
+            }
+            ++tag;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Determine whether or not the given text begins with the given
+     * string.
+     *
+     * @param[in] text
+     *     This points to the text to check.
+     *
+     * @param[in] length
+     *     This is the number of characters of text.
+     *
+     * @param[in] prefix
+     *     This is the string to look for.
+     *
+     * @return
+     *     An indication of whether or not the text begins with the
+     *     given string is returned.
+     */
+    bool StartsWith(const char* text, size_t length, const char* prefix) {
+        const auto prefixLength = strlen(prefix);
+        return (
+            (length >= prefixLength)
+            && (memcmp(text, prefix, prefixLength) == 0)
+        );
+    }
+
+    /**
+     * Append the UTF-8 encoding of the given Unicode code point to the
+     * given string.
+     *
+     * @param[in] codePoint
+     *     This is the code point to encode.
+     *
+     * @param[in,out] output
+     *     This is the string to which to append the encoding.
+     */
+    void AppendUtf8(uint32_t codePoint, std::string& output) {
+        if (codePoint < 0x80) {
+            output.push_back((char)codePoint);
+        } else if (codePoint < 0x800) {
+            output.push_back((char)(0xC0 | (codePoint >> 6)));
+            output.push_back((char)(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            output.push_back((char)(0xE0 | (codePoint >> 12)));
+            output.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+            output.push_back((char)(0x80 | (codePoint & 0x3F)));
+        } else {
+            output.push_back((char)(0xF0 | (codePoint >> 18)));
+            output.push_back((char)(0x80 | ((codePoint >> 12) & 0x3F)));
+            output.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+            output.push_back((char)(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    /**
+     * Decode the given entity or character reference, without its
+     * delimiting "&" and ";" characters.
+     *
+     * @param[in] reference
+     *     This points to the reference to decode.
+     *
+     * @param[in] length
+     *     This is the number of characters in the reference.
+     *
+     * @param[in,out] output
+     *     This is the string to which to append the characters the
+     *     reference represents.
+     *
+     * @return
+     *     An indication of whether or not the reference was recognized
+     *     is returned.
+     */
+    bool DecodeReference(const char* reference, size_t length, std::string& output) {
+        if (
+            (length >= 2)
+            && (reference[0] == '#')
+        ) {
+            uint32_t codePoint = 0;
+            size_t i = 1;
+            const bool hex = (reference[1] == 'x');
+            if (hex) {
+                ++i;
+            }
+            if (i == length) {
+                return false;
+            }
+            for (; i < length; ++i) {
+                const auto c = reference[i];
+                uint32_t digit;
+                if ((c >= '0') && (c <= '9')) {
+                    digit = (uint32_t)(c - '0');
+                } else if (hex && (c >= 'a') && (c <= 'f')) {
+                    digit = (uint32_t)(c - 'a' + 10);
+                } else if (hex && (c >= 'A') && (c <= 'F')) {
+                    digit = (uint32_t)(c - 'A' + 10);
+                } else {
+                    return false;
+                }
+                codePoint = codePoint * (hex ? 16 : 10) + digit;
+                if (codePoint > 0x10FFFF) {
+                    return false;
+                }
+            }
+            AppendUtf8(codePoint, output);
+            return true;
+        }
+        static const struct {
+            const char* name;
+            char c;
+        } entities[] = {
+            {"amp", '&'},
+            {"apos", '\''},
+            {"gt", '>'},
+            {"lt", '<'},
+            {"quot", '"'},
+        };
+        for (const auto& entity: entities) {
+            if (
+                (strlen(entity.name) == length)
+                && (memcmp(entity.name, reference, length) == 0)
+            ) {
+                output.push_back(entity.c);
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
+
+namespace Aws {
+
+    XmlParser::XmlParser(Handler& handler)
+        : handler_(handler)
+    {
+    }
+
+    bool XmlParser::Feed(const char* data, size_t length) {
+        if (failed_) {
+            return false;
+        }
+        if (buffer_.empty()) {
+            const auto consumed = ParseAvailable(data, length, false);
+            buffer_.assign(data + consumed, length - consumed);
+        } else {
+            buffer_.append(data, length);
+            const auto consumed = ParseAvailable(buffer_.data(), buffer_.length(), false);
+            buffer_.erase(0, consumed);
+        }
+        return !failed_;
+    }
+
+    bool XmlParser::Feed(const std::string& data) {
+        return Feed(data.data(), data.length());
+    }
+
+    bool XmlParser::Finish() {
+        if (!failed_) {
+            (void)ParseAvailable(buffer_.data(), buffer_.length(), true);
+        }
+        const bool wellFormed = (
+            !failed_
+            && openElementOffsets_.empty()
+        );
+        buffer_.clear();
+        openElementNames_.clear();
+        openElementOffsets_.clear();
+        failed_ = false;
+        return wellFormed;
+    }
+
+    bool XmlParser::Parse(const char* xml, size_t length) {
+        (void)Feed(xml, length);
+        return Finish();
+    }
+
+    bool XmlParser::Parse(const std::string& xml) {
+        return Parse(xml.data(), xml.length());
+    }
+
+    void XmlParser::DecodeReferences(
+        const char* text,
+        size_t length,
+        std::string& decoded
+    ) {
+        const auto end = text + length;
+        while (text < end) {
+            const auto ampersand = (const char*)memchr(text, '&', (size_t)(end - text));
+            if (ampersand == nullptr) {
+                decoded.append(text, (size_t)(end - text));
+                break;
+            }
+            decoded.append(text, (size_t)(ampersand - text));
+            const auto semicolon = (const char*)memchr(ampersand, ';', (size_t)(end - ampersand));
+            if (
+                (semicolon == nullptr)
+                || !DecodeReference(
+                    ampersand + 1,
+                    (size_t)(semicolon - ampersand - 1),
+                    decoded
+                )
+            ) {
+                decoded.push_back('&');
+                text = ampersand + 1;
+            } else {
+                text = semicolon + 1;
+            }
+        }
+    }
+
+    size_t XmlParser::ParseAvailable(const char* xml, size_t length, bool final) {
+        const auto end = xml + length;
+        auto next = xml;
+        while (next < end) {
+            if (*next != '<') {
+                auto textEnd = (const char*)memchr(next, '<', (size_t)(end - next));
+                bool heldBack = false;
+                if (textEnd == nullptr) {
+                    textEnd = end;
+
+                    // Hold back a reference which may be completed by
+                    // the next piece of the document.
+                    if (!final) {
+                        auto ampersand = end;
+                        while (
+                            (ampersand > next)
+                            && (ampersand[-1] != '&')
+                            && (ampersand[-1] != ';')
+                        ) {
+                            --ampersand;
+                        }
+                        if (
+                            (ampersand > next)
+                            && (ampersand[-1] == '&')
+                        ) {
+                            textEnd = ampersand - 1;
+                            heldBack = true;
+                        }
+                    }
+                }
+                if (
+                    (textEnd > next)
+                    && !openElementOffsets_.empty()
+                ) {
+                    ReportText(next, (size_t)(textEnd - next));
+                }
+                next = textEnd;
+                if (heldBack) {
+                    break;
+                }
+                continue;
+            }
+            const auto remaining = (size_t)(end - next);
+            const char* tokenEnd = nullptr;
+            if (StartsWith(next, remaining, "<!--")) {
+                const auto commentEnd = Find(next + 4, remaining - 4, "-->");
+                if (commentEnd != nullptr) {
+                    tokenEnd = commentEnd + 3;
+                }
+            } else if (StartsWith(next, remaining, "<![CDATA[")) {
+                const auto cdataEnd = Find(next + 9, remaining - 9, "]]>");
+                if (cdataEnd != nullptr) {
+                    if (openElementOffsets_.empty()) {
+                        failed_ = true;
+                        break;
+                    }
+                    if (cdataEnd > next + 9) {
+                        handler_.Text(next + 9, (size_t)(cdataEnd - next - 9));
+                    }
+                    tokenEnd = cdataEnd + 3;
+                }
+            } else if (StartsWith(next, remaining, "<?")) {
+                const auto instructionEnd = Find(next + 2, remaining - 2, "?>");
+                if (instructionEnd != nullptr) {
+                    tokenEnd = instructionEnd + 2;
+                }
+            } else {
+                const auto tagEnd = FindTagEnd(next, remaining);
+                if (tagEnd != nullptr) {
+                    if (next[1] == '!') {
+                        // Skip document type declarations.
+                    } else if (next[1] == '/') {
+                        if (!ParseEndTag(next + 2, (size_t)(tagEnd - next - 2))) {
+                            failed_ = true;
+                            break;
+                        }
+                    } else {
+                        if (!ParseStartTag(next + 1, (size_t)(tagEnd - next - 1))) {
+                            failed_ = true;
+                            break;
+                        }
+                    }
+                    tokenEnd = tagEnd + 1;
+                }
+            }
+            if (tokenEnd == nullptr) {
+                if (final) {
+                    failed_ = true;
+                }
+                break;
+            }
+            next = tokenEnd;
+        }
+        return (size_t)(next - xml);
+    }
+
+    void XmlParser::ReportText(const char* text, size_t length) {
+        if (memchr(text, '&', length) == nullptr) {
+            handler_.Text(text, length);
+        } else {
+            scratch_.clear();
+            DecodeReferences(text, length, scratch_);
+            handler_.Text(scratch_.data(), scratch_.length());
+        }
+    }
+
+    bool XmlParser::ParseStartTag(const char* tag, size_t length) {
+        const auto end = tag + length;
+        const bool isEmptyElement = (
+            (length > 0)
+            && (tag[length - 1] == '/')
+        );
+        const auto attributesEnd = (isEmptyElement ? end - 1 : end);
+        auto next = tag;
+        while (
+            (next < attributesEnd)
+            && !IsWhitespace(*next)
+        ) {
+            ++next;
+        }
+        const auto nameLength = (size_t)(next - tag);
+        if (nameLength == 0) {
+            return false;
+        }
+        handler_.StartElement(tag, nameLength);
+        for (;;) {
+            while (
+                (next < attributesEnd)
+                && IsWhitespace(*next)
+            ) {
+                ++next;
+            }
+            if (next == attributesEnd) {
+                break;
+            }
+            const auto attributeName = next;
+            while (
+                (next < attributesEnd)
+                && (*next != '=')
+                && !IsWhitespace(*next)
+            ) {
+                ++next;
+            }
+            const auto attributeNameLength = (size_t)(next - attributeName);
+            while (
+                (next < attributesEnd)
+                && IsWhitespace(*next)
+            ) {
+                ++next;
+            }
+            if (
+                (attributeNameLength == 0)
+                || (next == attributesEnd)
+                || (*next != '=')
+            ) {
+                return false;
+            }
+            ++next;
+            while (
+                (next < attributesEnd)
+                && IsWhitespace(*next)
+            ) {
+                ++next;
+            }
+            if (
+                (next == attributesEnd)
+                || ((*next != '"') && (*next != '\''))
+            ) {
+                return false;
+            }
+            const auto quote = *next++;
+            const auto valueEnd = (const char*)memchr(next, quote, (size_t)(attributesEnd - next));
+            if (valueEnd == nullptr) {
+                return false;
+            }
+            scratch_.clear();
+            DecodeReferences(next, (size_t)(valueEnd - next), scratch_);
+            handler_.Attribute(
+                attributeName,
+                attributeNameLength,
+                scratch_.data(),
+                scratch_.length()
+            );
+            next = valueEnd + 1;
+        }
+        if (isEmptyElement) {
+            handler_.EndElement(tag, nameLength);
+        } else {
+            openElementOffsets_.push_back(openElementNames_.length());
+            openElementNames_.append(tag, nameLength);
+        }
+        return true;
+    }
+
+    bool XmlParser::ParseEndTag(const char* tag, size_t length) {
+        while (
+            (length > 0)
+            && IsWhitespace(tag[length - 1])
+        ) {
+            --length;
+        }
+        if (openElementOffsets_.empty()) {
+            return false;
+        }
+        const auto offset = openElementOffsets_.back();
+        if (
+            (openElementNames_.length() - offset != length)
+            || (memcmp(openElementNames_.data() + offset, tag, length) != 0)
+        ) {
+            return false;
+        }
+        openElementOffsets_.pop_back();
+        openElementNames_.resize(offset);
+        handler_.EndElement(tag, length);
+        return true;
+    }
+
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+/**
+ * @file XmlParser.hpp
+ *
+ * This module declares the Aws::XmlParser class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Aws {
+
+    /**
+     * This class parses Extensible Markup Language (XML) documents,
+     * reporting the elements, attributes, and text it finds as events to
+     * a handler, in document order, rather than building a tree of the
+     * whole document.
+     *
+     * Names and text are reported as slices which refer either directly
+     * into the document or into a scratch buffer held by the parser, so
+     * they're only valid until the handler method returns.  Entity and
+     * character references in text and attribute values are replaced
+     * with the characters they represent before they're reported.
+     *
+     * Comments, processing instructions, and document type declarations
+     * are skipped.  The contents of CDATA sections are reported as text.
+     *
+     * A document may be given all at once, or a piece at a time as it
+     * arrives.  In the latter case, events are reported as soon as the
+     * markup or text they describe is complete, and only the incomplete
+     * markup or reference at the end of each piece is held back.
+     */
+    class XmlParser {
+        // Types
+    public:
+        /**
+         * This is the interface to the object which receives the events
+         * reported by the parser.
+         */
+        class Handler {
+        public:
+            virtual ~Handler() = default;
+
+            /**
+             * This is called when the start of an element is found.
+             *
+             * @param[in] name
+             *     This points to the name of the element.
+             *
+             * @param[in] nameLength
+             *     This is the number of characters in the name.
+             */
+            virtual void StartElement(const char* name, size_t nameLength) = 0;
+
+            /**
+             * This is called for each attribute of the element most
+             * recently started.
+             *
+             * @param[in] name
+             *     This points to the name of the attribute.
+             *
+             * @param[in] nameLength
+             *     This is the number of characters in the name.
+             *
+             * @param[in] value
+             *     This points to the value of the attribute.
+             *
+             * @param[in] valueLength
+             *     This is the number of characters in the value.
+             */
+            virtual void Attribute(
+                const char* name,
+                size_t nameLength,
+                const char* value,
+                size_t valueLength
+            ) {
+            }
+
+            /**
+             * This is called with text found inside an element.  The text
+             * of an element may be reported in more than one piece.
+             *
+             * @param[in] text
+             *     This points to the text.
+             *
+             * @param[in] length
+             *     This is the number of characters of text.
+             */
+            virtual void Text(const char* text, size_t length) = 0;
+
+            /**
+             * This is called when the end of an element is found.
+             *
+             * @param[in] name
+             *     This points to the name of the element.
+             *
+             * @param[in] nameLength
+             *     This is the number of characters in the name.
+             */
+            virtual void EndElement(const char* name, size_t nameLength) = 0;
+        };
+
+        // Public methods
+    public:
+        /**
+         * This constructor sets up the parser to report events to the
+         * given handler.
+         *
+         * @param[in] handler
+         *     This is the object which receives the events reported by
+         *     the parser.
+         */
+        explicit XmlParser(Handler& handler);
+
+        /**
+         * Parse the next piece of an XML document, reporting to the
+         * handler the contents of the document which are complete.
+         *
+         * @param[in] data
+         *     This points to the next piece of the document.
+         *
+         * @param[in] length
+         *     This is the number of characters in the piece.
+         *
+         * @return
+         *     An indication of whether or not the document has been
+         *     well-formed so far is returned.
+         */
+        bool Feed(const char* data, size_t length);
+
+        /**
+         * Parse the next piece of an XML document, reporting to the
+         * handler the contents of the document which are complete.
+         *
+         * @param[in] data
+         *     This is the next piece of the document.
+         *
+         * @return
+         *     An indication of whether or not the document has been
+         *     well-formed so far is returned.
+         */
+        bool Feed(const std::string& data);
+
+        /**
+         * Finish parsing the XML document given a piece at a time,
+         * reporting to the handler anything held back from the last
+         * piece.  After this, the parser is ready to parse another
+         * document.
+         *
+         * @return
+         *     An indication of whether or not the document was complete
+         *     and well-formed is returned.
+         */
+        bool Finish();
+
+        /**
+         * Parse the given XML document, reporting its contents to the
+         * handler.
+         *
+         * @param[in] xml
+         *     This points to the document to parse.
+         *
+         * @param[in] length
+         *     This is the number of characters in the document.
+         *
+         * @return
+         *     An indication of whether or not the document was well-formed
+         *     is returned.  Events are reported up to the point where any
+         *     problem is found.
+         */
+        bool Parse(const char* xml, size_t length);
+
+        /**
+         * Parse the given XML document, reporting its contents to the
+         * handler.
+         *
+         * @param[in] xml
+         *     This is the document to parse.
+         *
+         * @return
+         *     An indication of whether or not the document was well-formed
+         *     is returned.  Events are reported up to the point where any
+         *     problem is found.
+         */
+        bool Parse(const std::string& xml);
+
+        /**
+         * Replace any entity and character references in the given text
+         * with the characters they represent, appending the result to the
+         * given string.  Unrecognized references are left as they are.
+         *
+         * @param[in] text
+         *     This points to the text to decode.
+         *
+         * @param[in] length
+         *     This is the number of characters of text to decode.
+         *
+         * @param[in,out] decoded
+         *     This is the string to which to append the decoded text.
+         */
+        static void DecodeReferences(
+            const char* text,
+            size_t length,
+            std::string& decoded
+        );
+
+        // Private methods
+    private:
+        /**
+         * Parse as much of the given part of the document as possible,
+         * reporting its contents to the handler.
+         *
+         * @param[in] xml
+         *     This points to the part of the document to parse.
+         *
+         * @param[in] length
+         *     This is the number of characters in the part.
+         *
+         * @param[in] final
+         *     This indicates whether or not the part is the end of the
+         *     document, in which case nothing is held back.
+         *
+         * @return
+         *     The number of characters parsed is returned.  Any remaining
+         *     characters are incomplete markup or references, which must
+         *     be parsed again once more of the document is available.
+         */
+        size_t ParseAvailable(const char* xml, size_t length, bool final);
+
+        /**
+         * Report the given text to the handler, replacing any entity and
+         * character references it contains.
+         *
+         * @param[in] text
+         *     This points to the text to report.
+         *
+         * @param[in] length
+         *     This is the number of characters of text to report.
+         */
+        void ReportText(const char* text, size_t length);
+
+        /**
+         * Parse the start tag of an element, reporting the element and
+         * its attributes to the handler.
+         *
+         * @param[in] tag
+         *     This points to the characters of the tag between its
+         *     opening "<" and closing ">".
+         *
+         * @param[in] length
+         *     This is the number of characters in the tag.
+         *
+         * @return
+         *     An indication of whether or not the tag was well-formed
+         *     is returned.
+         */
+        bool ParseStartTag(const char* tag, size_t length);
+
+        /**
+         * Parse the end tag of an element, reporting the end of the
+         * element to the handler.
+         *
+         * @param[in] tag
+         *     This points to the characters of the tag between its
+         *     opening "</" and closing ">".
+         *
+         * @param[in] length
+         *     This is the number of characters in the tag.
+         *
+         * @return
+         *     An indication of whether or not the tag was well-formed
+         *     and matched the start tag of the element is returned.
+         */
+        bool ParseEndTag(const char* tag, size_t length);
+
+        // Private properties
+    private:
+        /**
+         * This is the object which receives the events reported by the
+         * parser.
+         */
+        Handler& handler_;
+
+        /**
+         * This holds the names of the elements which have been started
+         * but not yet ended, one after another.
+         */
+        std::string openElementNames_;
+
+        /**
+         * This holds the offset into openElementNames_ of the name of
+         * each element which has been started but not yet ended.
+         */
+        std::vector< size_t > openElementOffsets_;
+
+        /**
+         * This is used to hold text and attribute values while entity
+         * and character references are replaced in them.
+         */
+        std::string scratch_;
+
+        /**
+         * This holds the part of the document given so far which couldn't
+         * be parsed yet, because it's incomplete.
+         */
+        std::string buffer_;
+
+        /**
+         * This indicates whether or not the document has been found to
+         * be malformed.
+         */
+        bool failed_ = false;
+    };
+
+}
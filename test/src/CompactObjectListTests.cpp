@@ -0,0 +1,97 @@
+/**
+ * @file CompactObjectListTests.cpp
+ *
+ * This module contains the unit tests of the
+ * Aws::CompactObjectList structure.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <Aws/CompactObjectList.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string>
+
+TEST(CompactObjectListTests, AddObjects) {
+    Aws::CompactObjectList list;
+    EXPECT_EQ(0, list.GetSize());
+    const std::string key1 = "foo.txt";
+    const std::string eTag1 = "\"2f1020bd8ec6dcc71b2ee36ad3b577c4\"";
+    list.Add(key1.data(), key1.length(), eTag1.data(), eTag1.length(), 1551590536121, 156);
+    const std::string key2 = "photos/bar.jpg";
+    const std::string eTag2 = "0123456789ABCDEF0123456789abcdef";
+    list.Add(key2.data(), key2.length(), eTag2.data(), eTag2.length(), -1000, 0);
+    ASSERT_EQ(2, list.GetSize());
+    EXPECT_EQ("foo.txt", list.GetKey(0));
+    EXPECT_EQ("photos/bar.jpg", list.GetKey(1));
+    EXPECT_EQ(7, list.GetKeyLength(0));
+    EXPECT_EQ(14, list.GetKeyLength(1));
+    EXPECT_EQ("foo.txtphotos/bar.jpg", list.keys);
+    EXPECT_EQ("2f1020bd8ec6dcc71b2ee36ad3b577c4", list.GetETag(0));
+    EXPECT_EQ("0123456789abcdef0123456789abcdef", list.GetETag(1));
+    EXPECT_EQ(0x2f, list.eTagDigests[0][0]);
+    EXPECT_EQ(0xc4, list.eTagDigests[0][15]);
+    EXPECT_EQ(1551590536121, list.lastModified[0]);
+    EXPECT_EQ(-1000, list.lastModified[1]);
+    EXPECT_EQ(156, list.sizes[0]);
+    EXPECT_EQ(0, list.sizes[1]);
+    EXPECT_TRUE(list.irregularETags.empty());
+}
+
+TEST(CompactObjectListTests, MultipartETag) {
+    Aws::CompactObjectList list;
+    const std::string key = "big.bin";
+    const std::string eTag = "\"d41d8cd98f00b204e9800998ecf8427e-12\"";
+    list.Add(key.data(), key.length(), eTag.data(), eTag.length(), 0, 100000000);
+    ASSERT_EQ(1, list.GetSize());
+    EXPECT_EQ(12, list.eTagPartCounts[0]);
+    EXPECT_EQ("d41d8cd98f00b204e9800998ecf8427e-12", list.GetETag(0));
+    EXPECT_TRUE(list.irregularETags.empty());
+}
+
+TEST(CompactObjectListTests, IrregularETags) {
+    Aws::CompactObjectList list;
+    const std::string key = "x";
+    for (const auto& eTag: {
+        std::string("\"hello\""),
+        std::string("\"d41d8cd98f00b204e9800998ecf8427g\""),
+        std::string("\"d41d8cd98f00b204e9800998ecf8427e-\""),
+        std::string("\"d41d8cd98f00b204e9800998ecf8427e-0\""),
+        std::string("\"d41d8cd98f00b204e9800998ecf8427e-99999999999\""),
+        std::string("\"d41d8cd98f00b204e9800998ecf8427e0\""),
+        std::string(""),
+    }) {
+        list.Clear();
+        list.Add(key.data(), key.length(), eTag.data(), eTag.length(), 0, 0);
+        ASSERT_EQ(1, list.GetSize());
+        EXPECT_EQ(
+            ((eTag.length() >= 2) ? eTag.substr(1, eTag.length() - 2) : eTag),
+            list.GetETag(0)
+        ) << eTag;
+        EXPECT_EQ(1, list.irregularETags.size()) << eTag;
+        EXPECT_EQ(Aws::CompactObjectList::Digest(), list.eTagDigests[0]) << eTag;
+    }
+}
+
+TEST(CompactObjectListTests, EmptyKey) {
+    Aws::CompactObjectList list;
+    const std::string eTag = "2f1020bd8ec6dcc71b2ee36ad3b577c4";
+    list.Add("", 0, eTag.data(), eTag.length(), 0, 0);
+    list.Add("a", 1, eTag.data(), eTag.length(), 0, 0);
+    list.Add("", 0, eTag.data(), eTag.length(), 0, 0);
+    ASSERT_EQ(3, list.GetSize());
+    EXPECT_EQ("", list.GetKey(0));
+    EXPECT_EQ("a", list.GetKey(1));
+    EXPECT_EQ("", list.GetKey(2));
+}
+
+TEST(CompactObjectListTests, Clear) {
+    Aws::CompactObjectList list;
+    list.Reserve(10, 100);
+    const std::string eTag = "hello";
+    list.Add("a", 1, eTag.data(), eTag.length(), 0, 0);
+    list.Clear();
+    EXPECT_EQ(0, list.GetSize());
+    EXPECT_TRUE(list.keys.empty());
+    EXPECT_TRUE(list.irregularETags.empty());
+}
@@ -0,0 +1,60 @@
+/**
+ * @file IncrementalSha256Tests.cpp
+ *
+ * This module contains the unit tests of the
+ * Aws::IncrementalSha256 class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <gtest/gtest.h>
+#include <src/IncrementalSha256.hpp>
+#include <string>
+
+TEST(IncrementalSha256Tests, EmptyMessage) {
+    EXPECT_EQ(
+        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+        Aws::IncrementalSha256::HashAsHex("")
+    );
+}
+
+TEST(IncrementalSha256Tests, ShortMessage) {
+    EXPECT_EQ(
+        "dffd6021bb2bd5b0af676290809ec3a53191dd81c7f70a4b28688a362182986f",
+        Aws::IncrementalSha256::HashAsHex("Hello, World!")
+    );
+}
+
+TEST(IncrementalSha256Tests, MessageSpanningPaddingBoundary) {
+    EXPECT_EQ(
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+        Aws::IncrementalSha256::HashAsHex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")
+    );
+}
+
+TEST(IncrementalSha256Tests, MessageInPiecesMatchesWholeMessage) {
+    std::string message;
+    for (size_t i = 0; i < 1000; ++i) {
+        message.push_back((char)(i * 7));
+    }
+    const auto expectedDigest = Aws::IncrementalSha256::HashAsHex(message);
+    for (size_t pieceSize = 1; pieceSize < 200; pieceSize += 13) {
+        Aws::IncrementalSha256 hash;
+        for (size_t offset = 0; offset < message.length(); offset += pieceSize) {
+            hash.Append(message.substr(offset, pieceSize));
+        }
+        EXPECT_EQ(expectedDigest, hash.FinishAsHex()) << "piece size: " << pieceSize;
+    }
+}
+
+TEST(IncrementalSha256Tests, Reset) {
+    Aws::IncrementalSha256 hash;
+    hash.Append("PogChamp");
+    (void)hash.FinishAsHex();
+    hash.Reset();
+    hash.Append("Hello, World!");
+    EXPECT_EQ(
+        "dffd6021bb2bd5b0af676290809ec3a53191dd81c7f70a4b28688a362182986f",
+        hash.FinishAsHex()
+    );
+}
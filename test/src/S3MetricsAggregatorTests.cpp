@@ -0,0 +1,198 @@
+/**
+ * @file S3MetricsAggregatorTests.cpp
+ *
+ * This module contains the unit tests of the
+ * Aws::S3MetricsAggregator class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <Aws/S3.hpp>
+#include <Aws/S3MetricsAggregator.hpp>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <Http/IClient.hpp>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /**
+     * Make information about a completed request with the given
+     * properties.
+     *
+     * @param[in] operation
+     *     This is the kind of request.
+     *
+     * @param[in] statusCode
+     *     This is the HTTP status code from the response.
+     *
+     * @param[in] duration
+     *     This is how long the request took.
+     *
+     * @return
+     *     The information about the request is returned.
+     */
+    Aws::S3::RequestMetrics MakeMetrics(
+        Aws::S3::Operation operation,
+        unsigned int statusCode,
+        std::chrono::nanoseconds duration
+    ) {
+        Aws::S3::RequestMetrics metrics;
+        metrics.operation = operation;
+        metrics.bucketName = "my_bucket";
+        metrics.transactionState = Http::IClient::Transaction::State::Completed;
+        metrics.statusCode = statusCode;
+        metrics.duration = duration;
+        return metrics;
+    }
+
+}
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct S3MetricsAggregatorTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the unit under test.
+     */
+    Aws::S3MetricsAggregator aggregator;
+
+    // ::testing::Test
+
+    virtual void SetUp() override {
+    }
+
+    virtual void TearDown() override {
+    }
+};
+
+TEST_F(S3MetricsAggregatorTests, LatencyBuckets) {
+    typedef Aws::S3MetricsAggregator::LatencyHistogram LatencyHistogram;
+    size_t lastIndex = 0;
+    for (uint64_t nanoseconds = 0; nanoseconds < 100000; ++nanoseconds) {
+        const auto index = LatencyHistogram::GetBucketIndex(nanoseconds);
+        ASSERT_LT(index, LatencyHistogram::NUM_BUCKETS);
+        ASSERT_LE(lastIndex, index);
+        ASSERT_LE(LatencyHistogram::GetBucketLowerBound(index), nanoseconds);
+        ASSERT_GE(LatencyHistogram::GetBucketUpperBound(index), nanoseconds);
+        lastIndex = index;
+    }
+    for (size_t index = 0; index < LatencyHistogram::NUM_BUCKETS; ++index) {
+        const auto lowerBound = LatencyHistogram::GetBucketLowerBound(index);
+        const auto upperBound = LatencyHistogram::GetBucketUpperBound(index);
+        EXPECT_EQ(index, LatencyHistogram::GetBucketIndex(lowerBound));
+        EXPECT_EQ(index, LatencyHistogram::GetBucketIndex(upperBound));
+        EXPECT_LE((double)(upperBound - lowerBound), (double)lowerBound / 16.0);
+    }
+    EXPECT_EQ(LatencyHistogram::NUM_BUCKETS - 1, LatencyHistogram::GetBucketIndex(UINT64_MAX));
+}
+
+TEST_F(S3MetricsAggregatorTests, SnapshotEmptyInitially) {
+    EXPECT_TRUE(aggregator.GetSnapshot().empty());
+}
+
+TEST_F(S3MetricsAggregatorTests, CountersPerOperation) {
+    auto metrics = MakeMetrics(Aws::S3::Operation::PutObject, 200, std::chrono::milliseconds(5));
+    metrics.bytesSent = 1000;
+    aggregator.RequestCompleted(metrics);
+    metrics.statusCode = 503;
+    metrics.retries = 2;
+    aggregator.RequestCompleted(metrics);
+    metrics = MakeMetrics(Aws::S3::Operation::GetObject, 404, std::chrono::milliseconds(3));
+    metrics.bytesReceived = 75;
+    aggregator.RequestCompleted(metrics);
+    metrics.transactionState = Http::IClient::Transaction::State::UnableToConnect;
+    metrics.statusCode = 0;
+    metrics.bytesReceived = 0;
+    aggregator.RequestCompleted(metrics);
+    const auto snapshot = aggregator.GetSnapshot();
+    ASSERT_EQ(2, snapshot.size());
+    const auto& putObject = snapshot.at(Aws::S3::Operation::PutObject);
+    EXPECT_EQ(2, putObject.requests);
+    EXPECT_EQ(0, putObject.transactionFailures);
+    EXPECT_EQ(0, putObject.clientErrors);
+    EXPECT_EQ(1, putObject.serverErrors);
+    EXPECT_EQ(2, putObject.retries);
+    EXPECT_EQ(2000, putObject.bytesSent);
+    EXPECT_EQ(0, putObject.bytesReceived);
+    EXPECT_EQ(2, putObject.latency.GetCount());
+    const auto& getObject = snapshot.at(Aws::S3::Operation::GetObject);
+    EXPECT_EQ(2, getObject.requests);
+    EXPECT_EQ(1, getObject.transactionFailures);
+    EXPECT_EQ(1, getObject.clientErrors);
+    EXPECT_EQ(0, getObject.serverErrors);
+    EXPECT_EQ(0, getObject.retries);
+    EXPECT_EQ(0, getObject.bytesSent);
+    EXPECT_EQ(75, getObject.bytesReceived);
+    EXPECT_EQ(2, getObject.latency.GetCount());
+}
+
+TEST_F(S3MetricsAggregatorTests, LatencyPercentiles) {
+    for (int i = 1; i <= 100; ++i) {
+        aggregator.RequestCompleted(
+            MakeMetrics(Aws::S3::Operation::ListObjects, 200, std::chrono::milliseconds(i))
+        );
+    }
+    const auto snapshot = aggregator.GetSnapshot();
+    const auto& latency = snapshot.at(Aws::S3::Operation::ListObjects).latency;
+    EXPECT_EQ(100, latency.GetCount());
+    const auto expectPercentile = [&latency](double percentile, std::chrono::nanoseconds expected){
+        const auto actual = latency.GetPercentile(percentile);
+        EXPECT_GE(actual, expected) << percentile;
+        EXPECT_LE(actual, expected + expected / 16) << percentile;
+    };
+    expectPercentile(0.0, std::chrono::milliseconds(1));
+    expectPercentile(50.0, std::chrono::milliseconds(50));
+    expectPercentile(90.0, std::chrono::milliseconds(90));
+    expectPercentile(99.0, std::chrono::milliseconds(99));
+    expectPercentile(100.0, std::chrono::milliseconds(100));
+}
+
+TEST_F(S3MetricsAggregatorTests, Reset) {
+    aggregator.RequestCompleted(
+        MakeMetrics(Aws::S3::Operation::ListBuckets, 200, std::chrono::milliseconds(1))
+    );
+    EXPECT_EQ(1, aggregator.GetSnapshot().size());
+    aggregator.Reset();
+    EXPECT_TRUE(aggregator.GetSnapshot().empty());
+}
+
+TEST_F(S3MetricsAggregatorTests, RecordFromManyThreads) {
+    constexpr size_t numThreads = 4;
+    constexpr size_t requestsPerThread = 10000;
+    std::vector< std::thread > threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(
+            [this, i]{
+                auto metrics = MakeMetrics(
+                    Aws::S3::Operation::UploadPart,
+                    200,
+                    std::chrono::microseconds(i + 1)
+                );
+                metrics.bytesSent = 10;
+                for (size_t j = 0; j < requestsPerThread; ++j) {
+                    aggregator.RequestCompleted(metrics);
+                    if (j % 1000 == 0) {
+                        (void)aggregator.GetSnapshot();
+                    }
+                }
+            }
+        );
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    const auto snapshot = aggregator.GetSnapshot();
+    const auto& uploadPart = snapshot.at(Aws::S3::Operation::UploadPart);
+    EXPECT_EQ(numThreads * requestsPerThread, uploadPart.requests);
+    EXPECT_EQ(numThreads * requestsPerThread * 10, uploadPart.bytesSent);
+    EXPECT_EQ(numThreads * requestsPerThread, uploadPart.latency.GetCount());
+}
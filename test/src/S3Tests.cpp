@@ -7,11 +7,23 @@
  * © 2019 by Richard Walters
  */
 
+#include <algorithm>
 #include <Aws/Config.hpp>
 #include <Aws/S3.hpp>
+#include <Aws/S3Coroutines.hpp>
+#include <Aws/SignApi.hpp>
+#include <Aws/TimestampProvider.hpp>
 #include <future>
 #include <gtest/gtest.h>
 #include <Http/IClient.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -20,14 +32,22 @@ namespace {
     {
         // Properties
 
+        std::mutex mutex;
+        bool isComplete = false;
         std::function< void() > completionDelegate;
         std::promise< void > completed;
 
         // Methods
 
         void Complete() {
-            if (completionDelegate != nullptr) {
-                completionDelegate();
+            std::function< void() > completionDelegateToCall;
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                isComplete = true;
+                completionDelegateToCall = completionDelegate;
+            }
+            if (completionDelegateToCall != nullptr) {
+                completionDelegateToCall();
             }
             completed.set_value();
         }
@@ -47,7 +67,14 @@ namespace {
         virtual void SetCompletionDelegate(
             std::function< void() > completionDelegate
         ) {
-            this->completionDelegate = completionDelegate;
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                if (!isComplete) {
+                    this->completionDelegate = completionDelegate;
+                    return;
+                }
+            }
+            completionDelegate();
         }
     };
 
@@ -58,6 +85,7 @@ namespace {
 
         std::shared_ptr< MockHttpClentTransaction > transaction;
         std::promise< Http::Request > request;
+        std::function< void(const Http::Request& request, Http::Response& response) > responder;
 
         // Http::IClient
 
@@ -73,12 +101,56 @@ namespace {
             bool persistConnection = true,
             UpgradeDelegate upgradeDelegate = nullptr
         ) override {
+            if (responder != nullptr) {
+                const auto respondedTransaction = std::make_shared< MockHttpClentTransaction >();
+                responder(request, respondedTransaction->response);
+                respondedTransaction->state = Http::IClient::Transaction::State::Completed;
+                respondedTransaction->Complete();
+                return respondedTransaction;
+            }
             transaction = std::make_shared< MockHttpClentTransaction >();
             this->request.set_value(request);
             return transaction;
         }
     };
 
+    std::string PercentDecode(const std::string& input) {
+        std::string output;
+        for (size_t i = 0; i < input.length(); ++i) {
+            if (
+                (input[i] == '%')
+                && (i + 2 < input.length())
+            ) {
+                output.push_back((char)std::stoi(input.substr(i + 1, 2), nullptr, 16));
+                i += 2;
+            } else {
+                output.push_back(input[i]);
+            }
+        }
+        return output;
+    }
+
+    struct MockMetricsObserver
+        : public Aws::S3::MetricsObserver
+    {
+        // Properties
+
+        std::mutex mutex;
+        std::vector< Aws::S3::RequestMetrics > allMetrics;
+        size_t numMetricsExpected = 1;
+        std::promise< void > allReported;
+
+        // Aws::S3::MetricsObserver
+
+        virtual void RequestCompleted(const Aws::S3::RequestMetrics& metrics) override {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            allMetrics.push_back(metrics);
+            if (allMetrics.size() == numMetricsExpected) {
+                allReported.set_value();
+            }
+        }
+    };
+
 }
 
 /**
@@ -153,6 +225,230 @@ TEST_F(S3Tests, ListBuckets) {
     EXPECT_EQ(1528457143.456, listBuckets.buckets[1].creationDate);
 }
 
+TEST_F(S3Tests, RequestsDatedByTimestampProvider) {
+    Aws::Config config;
+    config.region = "foobar";
+    config.accessKeyId = "alex123";
+    config.secretAccessKey = "letmein";
+    s3.Configure(
+        mockClient,
+        config,
+        nullptr,
+        std::make_shared< Aws::TimestampProvider >([]{ return (time_t)1551590536; })
+    );
+    auto requestFuture = mockClient->request.get_future();
+    auto listObjectsFuture = s3.ListBuckets();
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("20190303T052216Z", request.headers.GetHeaderValue("x-amz-date"));
+    EXPECT_NE(
+        std::string::npos,
+        request.headers.GetHeaderValue("Authorization").find("/20190303/foobar/s3/aws4_request")
+    );
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 500;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+}
+
+TEST_F(S3Tests, RequestMetricsReported) {
+    const auto metricsObserver = std::make_shared< MockMetricsObserver >();
+    s3.SetMetricsObserver(metricsObserver);
+    auto metricsFuture = metricsObserver->allReported.get_future();
+    auto requestFuture = mockClient->request.get_future();
+    auto listObjectsFuture = s3.ListBuckets();
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.body = (
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+        "<ListAllMyBucketsResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+        "<Owner><ID>12345</ID><DisplayName>alex</DisplayName></Owner>"
+        "<Buckets>"
+        "<Bucket><Name>foo</Name><CreationDate>2018-02-01T08:30:12.123Z</CreationDate></Bucket>"
+        "</Buckets>"
+        "</ListAllMyBucketsResult>"
+    );
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        metricsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    std::lock_guard< decltype(metricsObserver->mutex) > lock(metricsObserver->mutex);
+    ASSERT_EQ(1, metricsObserver->allMetrics.size());
+    const auto& metrics = metricsObserver->allMetrics[0];
+    EXPECT_EQ(Aws::S3::Operation::ListBuckets, metrics.operation);
+    EXPECT_EQ("", metrics.bucketName);
+    EXPECT_EQ("GET", metrics.method);
+    EXPECT_EQ(Http::IClient::Transaction::State::Completed, metrics.transactionState);
+    EXPECT_EQ(200, metrics.statusCode);
+    EXPECT_EQ(0, metrics.bytesSent);
+    EXPECT_EQ(mockClient->transaction->response.body.length(), metrics.bytesReceived);
+    EXPECT_EQ(0, metrics.retries);
+    EXPECT_GE(metrics.duration, std::chrono::milliseconds(20));
+    EXPECT_GE(
+        metrics.duration,
+        metrics.timings.canonicalization + metrics.timings.signing + metrics.timings.transaction
+    );
+    EXPECT_GE(metrics.timings.queueWait.count(), 0);
+    EXPECT_GT(metrics.timings.canonicalization.count(), 0);
+    EXPECT_GT(metrics.timings.signing.count(), 0);
+    EXPECT_GE(metrics.timings.transaction, std::chrono::milliseconds(20));
+    EXPECT_GT(metrics.timings.parsing.count(), 0);
+    EXPECT_EQ(1, listObjectsFuture.get().buckets.size());
+}
+
+TEST_F(S3Tests, RequestMetricsReportedForEachRequest) {
+    const auto metricsObserver = std::make_shared< MockMetricsObserver >();
+    metricsObserver->numMetricsExpected = 2;
+    s3.SetMetricsObserver(metricsObserver);
+    mockClient->responder = [](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        if (request.method == "PUT") {
+            response.statusCode = 200;
+        } else {
+            response.statusCode = 404;
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<Error><Code>NoSuchKey</Code></Error>"
+            );
+        }
+        response.state = Http::Response::State::Complete;
+    };
+    EXPECT_EQ(200, s3.PutObject("my_bucket", "foo.txt", "Hello!").get().statusCode);
+    EXPECT_EQ(404, s3.GetObject("my_bucket", "bar.txt").get().statusCode);
+    auto allReportedFuture = metricsObserver->allReported.get_future();
+    ASSERT_EQ(
+        std::future_status::ready,
+        allReportedFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    std::lock_guard< decltype(metricsObserver->mutex) > lock(metricsObserver->mutex);
+    auto& allMetrics = metricsObserver->allMetrics;
+    std::sort(
+        allMetrics.begin(),
+        allMetrics.end(),
+        [](const Aws::S3::RequestMetrics& lhs, const Aws::S3::RequestMetrics& rhs){
+            return lhs.method > rhs.method;
+        }
+    );
+    EXPECT_EQ(Aws::S3::Operation::PutObject, allMetrics[0].operation);
+    EXPECT_EQ("my_bucket", allMetrics[0].bucketName);
+    EXPECT_EQ("PUT", allMetrics[0].method);
+    EXPECT_EQ(200, allMetrics[0].statusCode);
+    EXPECT_EQ(6, allMetrics[0].bytesSent);
+    EXPECT_EQ(0, allMetrics[0].bytesReceived);
+    EXPECT_EQ(Aws::S3::Operation::GetObject, allMetrics[1].operation);
+    EXPECT_EQ("my_bucket", allMetrics[1].bucketName);
+    EXPECT_EQ("GET", allMetrics[1].method);
+    EXPECT_EQ(404, allMetrics[1].statusCode);
+    EXPECT_EQ(0, allMetrics[1].bytesSent);
+    EXPECT_EQ(75, allMetrics[1].bytesReceived);
+    EXPECT_GT(allMetrics[1].timings.parsing.count(), 0);
+}
+
+TEST_F(S3Tests, RequestMetricsReportRetries) {
+    const auto metricsObserver = std::make_shared< MockMetricsObserver >();
+    metricsObserver->numMetricsExpected = 5;
+    s3.SetMetricsObserver(metricsObserver);
+    std::mutex mutex;
+    bool retried = false;
+    mockClient->responder = [&mutex, &retried](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        std::lock_guard< decltype(mutex) > lock(mutex);
+        const auto query = request.target.GetQuery();
+        response.statusCode = 200;
+        if (query == "uploads") {
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<InitiateMultipartUploadResult>"
+                    "<UploadId>abc</UploadId>"
+                "</InitiateMultipartUploadResult>"
+            );
+        } else if (query == "uploadId=abc") {
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<CompleteMultipartUploadResult>"
+                    "<ETag>&quot;final&quot;</ETag>"
+                "</CompleteMultipartUploadResult>"
+            );
+        } else if (!retried) {
+            retried = true;
+            response.statusCode = 503;
+        } else {
+            response.headers.SetHeader("ETag", "\"etag\"");
+        }
+        response.state = Http::Response::State::Complete;
+    };
+    const std::string contents(5 * 1024 * 1024 + 5, 'x');
+    size_t offset = 0;
+    auto uploadFuture = s3.UploadObject(
+        "my_bucket",
+        "my_object",
+        [&contents, &offset](char* buffer, size_t bufferSize){
+            const auto amount = std::min(bufferSize, contents.length() - offset);
+            (void)memcpy(buffer, contents.data() + offset, amount);
+            offset += amount;
+            return amount;
+        },
+        {},
+        10,
+        1
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        uploadFuture.wait_for(std::chrono::milliseconds(5000))
+    );
+    EXPECT_EQ(200, uploadFuture.get().statusCode);
+    auto allReportedFuture = metricsObserver->allReported.get_future();
+    ASSERT_EQ(
+        std::future_status::ready,
+        allReportedFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    std::lock_guard< decltype(metricsObserver->mutex) > lock(metricsObserver->mutex);
+    std::map< Aws::S3::Operation, std::vector< size_t > > retriesByOperation;
+    for (const auto& metrics: metricsObserver->allMetrics) {
+        EXPECT_EQ("my_bucket", metrics.bucketName);
+        retriesByOperation[metrics.operation].push_back(metrics.retries);
+    }
+    for (auto& retries: retriesByOperation) {
+        std::sort(retries.second.begin(), retries.second.end());
+    }
+    EXPECT_EQ(
+        (std::map< Aws::S3::Operation, std::vector< size_t > >{
+            {Aws::S3::Operation::CreateMultipartUpload, {0}},
+            {Aws::S3::Operation::UploadPart, {0, 0, 1}},
+            {Aws::S3::Operation::CompleteMultipartUpload, {0}},
+        }),
+        retriesByOperation
+    );
+}
+
+TEST_F(S3Tests, OperationNames) {
+    EXPECT_EQ("ListBuckets", std::string(Aws::S3::GetOperationName(Aws::S3::Operation::ListBuckets)));
+    EXPECT_EQ("ListObjects", std::string(Aws::S3::GetOperationName(Aws::S3::Operation::ListObjects)));
+    EXPECT_EQ("GetObject", std::string(Aws::S3::GetOperationName(Aws::S3::Operation::GetObject)));
+    EXPECT_EQ("PutObject", std::string(Aws::S3::GetOperationName(Aws::S3::Operation::PutObject)));
+    EXPECT_EQ("CreateMultipartUpload", std::string(Aws::S3::GetOperationName(Aws::S3::Operation::CreateMultipartUpload)));
+    EXPECT_EQ("UploadPart", std::string(Aws::S3::GetOperationName(Aws::S3::Operation::UploadPart)));
+    EXPECT_EQ("CompleteMultipartUpload", std::string(Aws::S3::GetOperationName(Aws::S3::Operation::CompleteMultipartUpload)));
+    EXPECT_EQ("AbortMultipartUpload", std::string(Aws::S3::GetOperationName(Aws::S3::Operation::AbortMultipartUpload)));
+}
+
 TEST_F(S3Tests, ListObjects) {
     auto requestFuture = mockClient->request.get_future();
     auto listObjectsFuture = s3.ListObjects("my_bucket");
@@ -215,76 +511,1516 @@ TEST_F(S3Tests, ListObjects) {
     EXPECT_EQ(317, listObjects.objects[1].size);
 }
 
-TEST_F(S3Tests, GetObject) {
+TEST_F(S3Tests, ListObjectsDecodesReferences) {
+    mockClient->responder = [](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        response.statusCode = 200;
+        response.body = (
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">\n"
+            "  <IsTruncated>false</IsTruncated>\n"
+            "  <Contents>\n"
+            "    <Key>Tom &amp; Jerry &lt;1&gt;.txt</Key>\n"
+            "    <LastModified>2019-03-03T05:22:16.121Z</LastModified>\n"
+            "    <ETag>&quot;2f1020bd8ec6dcc71b2ee36ad3b577c4&quot;</ETag>\n"
+            "    <Size>156</Size>\n"
+            "  </Contents>\n"
+            "</ListBucketResult>\n"
+        );
+        response.state = Http::Response::State::Complete;
+    };
+    auto listObjectsFuture = s3.ListObjects("my_bucket");
+    ASSERT_EQ(
+        std::future_status::ready,
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto listObjects = listObjectsFuture.get();
+    EXPECT_EQ(200, listObjects.statusCode);
+    ASSERT_EQ(1, listObjects.objects.size());
+    EXPECT_EQ("Tom & Jerry <1>.txt", listObjects.objects[0].key);
+    EXPECT_EQ("2f1020bd8ec6dcc71b2ee36ad3b577c4", listObjects.objects[0].eTag);
+    EXPECT_EQ(1551590536.121, listObjects.objects[0].lastModified);
+    EXPECT_EQ(156, listObjects.objects[0].size);
+}
+
+TEST_F(S3Tests, ListObjectsWithOptions) {
     auto requestFuture = mockClient->request.get_future();
-    auto getObjectFuture = s3.GetObject("my_bucket", "my_object");
+    Aws::S3::ListObjectsOptions options;
+    options.prefix = "photos/";
+    options.delimiter = "/";
+    options.startAfter = "photos/a";
+    options.maxKeys = 50;
+    auto listObjectsFuture = s3.ListObjects("my_bucket", options);
     ASSERT_EQ(
         std::future_status::ready,
         requestFuture.wait_for(std::chrono::milliseconds(100))
     );
     auto request = requestFuture.get();
     EXPECT_EQ("GET", request.method);
-    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object", request.target.GenerateString());
-    EXPECT_TRUE(request.headers.HasHeader("x-amz-date"));
-    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
-    EXPECT_TRUE(request.headers.HasHeader("x-amz-content-sha256"));
-    EXPECT_NE(
-        std::future_status::ready,
-        getObjectFuture.wait_for(std::chrono::seconds(0))
+    EXPECT_EQ(
+        std::vector< std::string >({"", "my_bucket"}),
+        request.target.GetPath()
+    );
+    EXPECT_EQ(
+        "list-type=2&delimiter=%2F&max-keys=50&prefix=photos%2F&start-after=photos%2Fa",
+        request.target.GetQuery()
     );
     mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
     mockClient->transaction->response.statusCode = 200;
-    mockClient->transaction->response.headers.AddHeader("Content-Type", "text/plain");
-    mockClient->transaction->response.headers.AddHeader("Cache-Control", "max-age=0");
-    mockClient->transaction->response.body = "PogChamp";
+    mockClient->transaction->response.body = (
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+        "<Name>my_bucket</Name>"
+        "<Prefix>photos/</Prefix>"
+        "<KeyCount>3</KeyCount>"
+        "<MaxKeys>50</MaxKeys>"
+        "<Delimiter>/</Delimiter>"
+        "<IsTruncated>false</IsTruncated>"
+        "<Contents>"
+        "<Key>photos/b.jpg</Key>"
+        "<LastModified>2019-03-03T05:22:16.121Z</LastModified>"
+        "<ETag>&quot;2f1020bd8ec6dcc71b2ee36ad3b577c4&quot;</ETag>"
+        "<Size>156</Size>"
+        "<StorageClass>STANDARD</StorageClass>"
+        "</Contents>"
+        "<CommonPrefixes>"
+        "<Prefix>photos/2018/</Prefix>"
+        "</CommonPrefixes>"
+        "<CommonPrefixes>"
+        "<Prefix>photos/2019/</Prefix>"
+        "</CommonPrefixes>"
+        "</ListBucketResult>"
+    );
     mockClient->transaction->response.state = Http::Response::State::Complete;
     mockClient->transaction->Complete();
     ASSERT_EQ(
         std::future_status::ready,
-        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto listObjects = listObjectsFuture.get();
+    EXPECT_EQ(200, listObjects.statusCode);
+    ASSERT_EQ(1, listObjects.objects.size());
+    EXPECT_EQ("photos/b.jpg", listObjects.objects[0].key);
+    EXPECT_EQ(
+        std::vector< std::string >({"photos/2018/", "photos/2019/"}),
+        listObjects.commonPrefixes
     );
-    auto getObject = getObjectFuture.get();
-    EXPECT_EQ(200, getObject.statusCode);
-    EXPECT_EQ("PogChamp", getObject.content);
-    EXPECT_EQ("text/plain", getObject.headers.GetHeaderValue("Content-Type"));
-    EXPECT_EQ("max-age=0", getObject.headers.GetHeaderValue("Cache-Control"));
 }
 
-TEST_F(S3Tests, PutObject) {
-    auto requestFuture = mockClient->request.get_future();
-    auto putObjectFuture = s3.PutObject(
-        "my_bucket",
-        "my_object",
-        "Hello, World!",
+TEST_F(S3Tests, ListObjectsParsesTimestamps) {
+    const std::vector< std::string > timestamps = {
+        "1970-01-01T00:00:00.000Z",
+        "1972-02-29T12:00:00.001Z",
+        "1999-12-31T23:59:59.999Z",
+        "2000-02-29T23:59:59.500Z",
+        "2000-03-01T00:00:00.000Z",
+        "2038-01-19T03:14:07.000Z",
+        "2019-03-03T05:22:16Z",
+    };
+    const std::vector< double > expectedLastModified = {
+        0.0,
+        68212800.0 + 1.0 / 1000.0,
+        946684799.0 + 999.0 / 1000.0,
+        951868799.0 + 500.0 / 1000.0,
+        951868800.0,
+        2147483647.0,
+        1551590536.0,
+    };
+    mockClient->responder = [&timestamps](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        response.statusCode = 200;
+        response.body = (
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<ListBucketResult>"
+            "<IsTruncated>false</IsTruncated>"
+        );
+        for (const auto& timestamp: timestamps) {
+            response.body += (
+                "<Contents>"
+                "<Key>" + timestamp + "</Key>"
+                "<LastModified>" + timestamp + "</LastModified>"
+                "<ETag>&quot;2f1020bd8ec6dcc71b2ee36ad3b577c4&quot;</ETag>"
+                "<Size>156</Size>"
+                "</Contents>"
+            );
+        }
+        response.body += "</ListBucketResult>";
+        response.state = Http::Response::State::Complete;
+    };
+    auto listObjectsFuture = s3.ListObjects("my_bucket");
+    ASSERT_EQ(
+        std::future_status::ready,
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto listObjects = listObjectsFuture.get();
+    ASSERT_EQ(timestamps.size(), listObjects.objects.size());
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        EXPECT_EQ(expectedLastModified[i], listObjects.objects[i].lastModified) << timestamps[i];
+    }
+}
+
+TEST_F(S3Tests, ListObjectsCompact) {
+    std::mutex mutex;
+    std::vector< std::string > tokensRequested;
+    mockClient->responder = [&mutex, &tokensRequested](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        const auto query = request.target.GetQuery();
+        const auto delimiter = query.find("continuation-token=");
+        const auto token = (
+            (delimiter == std::string::npos)
+            ? std::string()
+            : query.substr(delimiter + 19)
+        );
         {
-            {"Cache-Control", "max-age=0"},
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            tokensRequested.push_back(token);
+        }
+        response.statusCode = 200;
+        if (token.empty()) {
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<ListBucketResult>"
+                "<IsTruncated>true</IsTruncated>"
+                "<NextContinuationToken>2</NextContinuationToken>"
+                "<Contents>"
+                "<Key>foo&amp;bar.txt</Key>"
+                "<LastModified>2019-03-03T05:22:16.121Z</LastModified>"
+                "<ETag>&quot;2f1020bd8ec6dcc71b2ee36ad3b577c4&quot;</ETag>"
+                "<Size>156</Size>"
+                "</Contents>"
+                "<CommonPrefixes>"
+                "<Prefix>photos/</Prefix>"
+                "</CommonPrefixes>"
+                "</ListBucketResult>"
+            );
+        } else {
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<ListBucketResult>"
+                "<IsTruncated>false</IsTruncated>"
+                "<Contents>"
+                "<Key>big.bin</Key>"
+                "<LastModified>1970-01-01T00:00:01.000Z</LastModified>"
+                "<ETag>&quot;d41d8cd98f00b204e9800998ecf8427e-3&quot;</ETag>"
+                "<Size>25000000000</Size>"
+                "</Contents>"
+                "</ListBucketResult>"
+            );
+        }
+        response.state = Http::Response::State::Complete;
+    };
+    auto listObjectsFuture = s3.ListObjectsCompact("my_bucket");
+    ASSERT_EQ(
+        std::future_status::ready,
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto listObjects = listObjectsFuture.get();
+    EXPECT_EQ(200, listObjects.statusCode);
+    ASSERT_EQ(2, listObjects.objects.GetSize());
+    EXPECT_EQ("foo&bar.txt", listObjects.objects.GetKey(0));
+    EXPECT_EQ("2f1020bd8ec6dcc71b2ee36ad3b577c4", listObjects.objects.GetETag(0));
+    EXPECT_EQ(1551590536121, listObjects.objects.lastModified[0]);
+    EXPECT_EQ(156, listObjects.objects.sizes[0]);
+    EXPECT_EQ("big.bin", listObjects.objects.GetKey(1));
+    EXPECT_EQ("d41d8cd98f00b204e9800998ecf8427e-3", listObjects.objects.GetETag(1));
+    EXPECT_EQ(1000, listObjects.objects.lastModified[1]);
+    EXPECT_EQ(25000000000, listObjects.objects.sizes[1]);
+    EXPECT_EQ(
+        std::vector< std::string >({"photos/"}),
+        listObjects.commonPrefixes
+    );
+    EXPECT_EQ(
+        std::vector< std::string >({"", "2"}),
+        tokensRequested
+    );
+}
+
+TEST_F(S3Tests, ListObjectsTruncatedPageBody) {
+    std::mutex mutex;
+    size_t requests = 0;
+    mockClient->responder = [&mutex, &requests](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            ++requests;
         }
+        response.statusCode = 200;
+        response.body = (
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<ListBucketResult>"
+            "<IsTruncated>true</IsTruncated>"
+            "<NextContinuationToken>2</NextContinuationToken>"
+            "<Contents>"
+            "<Key>test1.txt</Key>"
+            "<Size>156</Size>"
+            "</Contents>"
+            "<Contents>"
+            "<Key>tes"
+        );
+        response.state = Http::Response::State::Complete;
+    };
+    auto listObjectsFuture = s3.ListObjects("my_bucket");
+    ASSERT_EQ(
+        std::future_status::ready,
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto listObjects = listObjectsFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Broken, listObjects.transactionState);
+    auto compactFuture = s3.ListObjectsCompact("my_bucket");
+    ASSERT_EQ(
+        std::future_status::ready,
+        compactFuture.wait_for(std::chrono::milliseconds(1000))
     );
+    auto compact = compactFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Broken, compact.transactionState);
+    EXPECT_EQ(2, requests);
+}
+
+TEST_F(S3Tests, ListObjectsPage) {
+    auto requestFuture = mockClient->request.get_future();
+    auto pageFuture = s3.ListObjectsPage("my_bucket", "abc");
     ASSERT_EQ(
         std::future_status::ready,
         requestFuture.wait_for(std::chrono::milliseconds(100))
     );
     auto request = requestFuture.get();
-    EXPECT_EQ("PUT", request.method);
-    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object", request.target.GenerateString());
-    EXPECT_TRUE(request.headers.HasHeader("x-amz-date"));
-    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
-    EXPECT_TRUE(request.headers.HasHeader("x-amz-content-sha256"));
-    EXPECT_EQ("max-age=0", request.headers.GetHeaderValue("Cache-Control"));
-    EXPECT_EQ("13", request.headers.GetHeaderValue("Content-Length"));
-    EXPECT_EQ("Hello, World!", request.body);
-    EXPECT_NE(
+    EXPECT_EQ("GET", request.method);
+    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket?list-type=2&continuation-token=abc", request.target.GenerateString());
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.body = (
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+        "<Name>my_bucket</Name>"
+        "<KeyCount>1</KeyCount>"
+        "<IsTruncated>true</IsTruncated>"
+        "<NextContinuationToken>def</NextContinuationToken>"
+        "<Contents>"
+        "<Key>test1.txt</Key>"
+        "<LastModified>2019-03-03T05:22:16.121Z</LastModified>"
+        "<ETag>&quot;2f1020bd8ec6dcc71b2ee36ad3b577c4&quot;</ETag>"
+        "<Size>156</Size>"
+        "</Contents>"
+        "</ListBucketResult>"
+    );
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
         std::future_status::ready,
-        putObjectFuture.wait_for(std::chrono::seconds(0))
+        pageFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto page = pageFuture.get();
+    EXPECT_EQ(200, page.statusCode);
+    ASSERT_EQ(1, page.objects.size());
+    EXPECT_EQ("test1.txt", page.objects[0].key);
+    EXPECT_TRUE(page.isTruncated);
+    EXPECT_EQ("def", page.nextContinuationToken);
+}
+
+TEST_F(S3Tests, ListObjectsInPages) {
+    std::mutex mutex;
+    std::vector< std::string > tokensRequested;
+    mockClient->responder = [&mutex, &tokensRequested](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        const auto query = request.target.GetQuery();
+        const auto delimiter = query.find("continuation-token=");
+        const auto token = (
+            (delimiter == std::string::npos)
+            ? std::string()
+            : query.substr(delimiter + 19)
+        );
+        {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            tokensRequested.push_back(token);
+        }
+        const auto pageNumber = (token.empty() ? 1 : (token[0] - '0'));
+        response.statusCode = 200;
+        response.body = (
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<ListBucketResult>"
+        );
+        if (pageNumber < 3) {
+            response.body += (
+                "<IsTruncated>true</IsTruncated>"
+                "<NextContinuationToken>" + std::to_string(pageNumber + 1) + "</NextContinuationToken>"
+            );
+        } else {
+            response.body += "<IsTruncated>false</IsTruncated>";
+        }
+        for (int i = 0; i < 2; ++i) {
+            response.body += (
+                "<Contents>"
+                "<Key>page" + std::to_string(pageNumber) + "-" + std::to_string(i) + "</Key>"
+                "<LastModified>2019-03-03T05:22:16.121Z</LastModified>"
+                "<ETag>&quot;2f1020bd8ec6dcc71b2ee36ad3b577c4&quot;</ETag>"
+                "<Size>156</Size>"
+                "</Contents>"
+            );
+        }
+        response.body += "</ListBucketResult>";
+        response.state = Http::Response::State::Complete;
+    };
+    std::vector< std::string > keys;
+    size_t numPages = 0;
+    for (const auto& page: s3.ListObjectsInPages("my_bucket")) {
+        EXPECT_EQ(200, page.statusCode);
+        ++numPages;
+        for (const auto& object: page.objects) {
+            keys.push_back(object.key);
+        }
+    }
+    EXPECT_EQ(3, numPages);
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "page1-0", "page1-1",
+            "page2-0", "page2-1",
+            "page3-0", "page3-1",
+        }),
+        keys
+    );
+    EXPECT_EQ(
+        std::vector< std::string >({"", "2", "3"}),
+        tokensRequested
+    );
+}
+
+TEST_F(S3Tests, ListObjectsInPagesPrefetchesNextPage) {
+    std::mutex mutex;
+    size_t numRequests = 0;
+    mockClient->responder = [&mutex, &numRequests](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            ++numRequests;
+        }
+        response.statusCode = 200;
+        response.body = (
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<ListBucketResult>"
+            "<IsTruncated>true</IsTruncated>"
+            "<NextContinuationToken>abc</NextContinuationToken>"
+            "</ListBucketResult>"
+        );
+        response.state = Http::Response::State::Complete;
+    };
+    auto pages = s3.ListObjectsInPages("my_bucket");
+    Aws::S3::ListObjectsPageResult page;
+    ASSERT_TRUE(pages.GetNextPage(page));
+    EXPECT_TRUE(page.isTruncated);
+    bool prefetched = false;
+    for (size_t i = 0; i < 100; ++i) {
+        {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            if (numRequests == 2) {
+                prefetched = true;
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(prefetched);
+}
+
+TEST_F(S3Tests, ListObjectsQueryValuesEncoded) {
+    auto requestFuture = mockClient->request.get_future();
+    Aws::S3::ListObjectsOptions options;
+    options.prefix = "a&b+c d/";
+    options.startAfter = "a&b+c d/e=f";
+    auto listObjectsFuture = s3.ListObjects("my_bucket", options);
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ(
+        "list-type=2&prefix=a%26b%2Bc%20d%2F&start-after=a%26b%2Bc%20d%2Fe%3Df",
+        request.target.GetQuery()
     );
+    const auto canonicalRequest = Aws::SignApi::ConstructCanonicalRequest(request).text;
+    EXPECT_NE(
+        std::string::npos,
+        canonicalRequest.find(
+            "\nlist-type=2&prefix=a%26b%2Bc%20d%2F&start-after=a%26b%2Bc%20d%2Fe%3Df\n"
+        )
+    ) << canonicalRequest;
     mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
     mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.body = (
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+        "<ListBucketResult>"
+        "<IsTruncated>false</IsTruncated>"
+        "</ListBucketResult>"
+    );
     mockClient->transaction->response.state = Http::Response::State::Complete;
     mockClient->transaction->Complete();
     ASSERT_EQ(
         std::future_status::ready,
-        putObjectFuture.wait_for(std::chrono::milliseconds(1000))
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
     );
-    auto putObject = putObjectFuture.get();
-    EXPECT_EQ(200, putObject.statusCode);
+    EXPECT_EQ(200, listObjectsFuture.get().statusCode);
 }
+
+TEST_F(S3Tests, ListObjectsInParallel) {
+    std::vector< std::string > keys;
+    for (char prefix = 'a'; prefix <= 'e'; ++prefix) {
+        for (char suffix = '0'; suffix <= '4'; ++suffix) {
+            keys.push_back(std::string({prefix, '/', suffix}));
+        }
+    }
+    std::mutex mutex;
+    std::set< std::string > startAfters;
+    mockClient->responder = [&keys, &mutex, &startAfters](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        // Simulate S3 listing the keys three at a time, where the
+        // continuation token is the last key listed.
+        std::string startAfter, continuationToken;
+        const auto query = request.target.GetQuery();
+        size_t offset = 0;
+        while (offset < query.length()) {
+            auto end = query.find('&', offset);
+            if (end == std::string::npos) {
+                end = query.length();
+            }
+            const auto parameter = query.substr(offset, end - offset);
+            const auto delimiter = parameter.find('=');
+            const auto name = parameter.substr(0, delimiter);
+            const auto value = PercentDecode(parameter.substr(delimiter + 1));
+            if (name == "start-after") {
+                startAfter = value;
+            } else if (name == "continuation-token") {
+                continuationToken = value;
+            }
+            offset = end + 1;
+        }
+        if (continuationToken.empty()) {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            (void)startAfters.insert(startAfter);
+        } else {
+            startAfter = continuationToken;
+        }
+        auto key = std::upper_bound(keys.begin(), keys.end(), startAfter);
+        response.statusCode = 200;
+        response.body = (
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<ListBucketResult>"
+        );
+        for (size_t i = 0; (i < 3) && (key != keys.end()); ++i, ++key) {
+            response.body += (
+                "<Contents>"
+                "<Key>" + *key + "</Key>"
+                "<LastModified>2019-03-03T05:22:16.121Z</LastModified>"
+                "<ETag>&quot;2f1020bd8ec6dcc71b2ee36ad3b577c4&quot;</ETag>"
+                "<Size>156</Size>"
+                "</Contents>"
+            );
+        }
+        if (key == keys.end()) {
+            response.body += "<IsTruncated>false</IsTruncated>";
+        } else {
+            response.body += (
+                "<IsTruncated>true</IsTruncated>"
+                "<NextContinuationToken>" + *(key - 1) + "</NextContinuationToken>"
+            );
+        }
+        response.body += "</ListBucketResult>";
+        response.state = Http::Response::State::Complete;
+    };
+    auto listObjectsFuture = s3.ListObjectsInParallel(
+        "my_bucket",
+        {"d/", "b/", "c/2"},
+        2
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto listObjects = listObjectsFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Completed, listObjects.transactionState);
+    EXPECT_EQ(200, listObjects.statusCode);
+    std::vector< std::string > keysListed;
+    for (const auto& object: listObjects.objects) {
+        keysListed.push_back(object.key);
+    }
+    EXPECT_EQ(keys, keysListed);
+    EXPECT_EQ(
+        std::set< std::string >({"", "b/", "c/2", "d/"}),
+        startAfters
+    );
+}
+
+TEST_F(S3Tests, ListObjectsInParallelPartitionFails) {
+    mockClient->responder = [](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        if (request.target.GetQuery().find("start-after=m") == std::string::npos) {
+            response.statusCode = 200;
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<ListBucketResult>"
+                "<IsTruncated>false</IsTruncated>"
+                "</ListBucketResult>"
+            );
+        } else {
+            response.statusCode = 403;
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<Error><Code>AccessDenied</Code></Error>"
+            );
+        }
+        response.state = Http::Response::State::Complete;
+    };
+    auto listObjectsFuture = s3.ListObjectsInParallel("my_bucket", {"m"});
+    ASSERT_EQ(
+        std::future_status::ready,
+        listObjectsFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto listObjects = listObjectsFuture.get();
+    EXPECT_EQ(403, listObjects.statusCode);
+    EXPECT_EQ("AccessDenied", (std::string)listObjects.errorInfo["Code"]);
+}
+
+TEST_F(S3Tests, GetObject) {
+    auto requestFuture = mockClient->request.get_future();
+    auto getObjectFuture = s3.GetObject("my_bucket", "my_object");
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("GET", request.method);
+    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object", request.target.GenerateString());
+    EXPECT_TRUE(request.headers.HasHeader("x-amz-date"));
+    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
+    EXPECT_TRUE(request.headers.HasHeader("x-amz-content-sha256"));
+    EXPECT_NE(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::seconds(0))
+    );
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.headers.AddHeader("Content-Type", "text/plain");
+    mockClient->transaction->response.headers.AddHeader("Cache-Control", "max-age=0");
+    mockClient->transaction->response.body = "PogChamp";
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto getObject = getObjectFuture.get();
+    EXPECT_EQ(200, getObject.statusCode);
+    EXPECT_EQ("PogChamp", getObject.content);
+    EXPECT_EQ("text/plain", getObject.headers.GetHeaderValue("Content-Type"));
+    EXPECT_EQ("max-age=0", getObject.headers.GetHeaderValue("Cache-Control"));
+}
+
+TEST_F(S3Tests, GetObjectIntoContentSink) {
+    std::string contents(25, 'x');
+    for (size_t i = 0; i < contents.length(); ++i) {
+        contents[i] = (char)('a' + i);
+    }
+    std::vector< std::string > ranges;
+    std::vector< std::string > eTags;
+    mockClient->responder = [&contents, &ranges, &eTags](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        size_t first, last;
+        const auto range = request.headers.GetHeaderValue("Range");
+        ranges.push_back(range);
+        eTags.push_back(request.headers.GetHeaderValue("If-Match"));
+        ASSERT_EQ(2, sscanf(range.c_str(), "bytes=%zu-%zu", &first, &last));
+        last = std::min(last, contents.length() - 1);
+        response.statusCode = 206;
+        response.headers.SetHeader("ETag", "\"abc\"");
+        response.headers.SetHeader(
+            "Content-Range",
+            "bytes " + std::to_string(first) + "-" + std::to_string(last)
+            + "/" + std::to_string(contents.length())
+        );
+        response.body = contents.substr(first, last - first + 1);
+        response.state = Http::Response::State::Complete;
+    };
+    std::vector< std::string > pieces;
+    auto getObjectFuture = s3.GetObject(
+        "my_bucket",
+        "my_object",
+        [&pieces](const char* data, size_t size){
+            pieces.push_back(std::string(data, size));
+            return true;
+        },
+        10
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto getObject = getObjectFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Completed, getObject.transactionState);
+    EXPECT_EQ(200, getObject.statusCode);
+    EXPECT_TRUE(getObject.content.empty());
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "bytes=0-9",
+            "bytes=10-19",
+            "bytes=20-29",
+        }),
+        ranges
+    );
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "",
+            "\"abc\"",
+            "\"abc\"",
+        }),
+        eTags
+    );
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "abcdefghij",
+            "klmnopqrst",
+            "uvwxy",
+        }),
+        pieces
+    );
+}
+
+TEST_F(S3Tests, GetObjectIntoContentSinkAborted) {
+    mockClient->responder = [](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        response.statusCode = 206;
+        response.headers.SetHeader("Content-Range", "bytes 0-9/100");
+        response.body = "0123456789";
+        response.state = Http::Response::State::Complete;
+    };
+    size_t piecesReceived = 0;
+    auto getObjectFuture = s3.GetObject(
+        "my_bucket",
+        "my_object",
+        [&piecesReceived](const char* data, size_t size){
+            ++piecesReceived;
+            return false;
+        },
+        10
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto getObject = getObjectFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Broken, getObject.transactionState);
+    EXPECT_EQ(1, piecesReceived);
+}
+
+TEST_F(S3Tests, GetObjectIntoBuffer) {
+    const std::string contents = "Hello, World!";
+    mockClient->responder = [&contents](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        EXPECT_EQ("bytes=0-19", request.headers.GetHeaderValue("Range"));
+        response.statusCode = 206;
+        response.headers.SetHeader("Content-Range", "bytes 0-12/13");
+        response.body = contents;
+        response.state = Http::Response::State::Complete;
+    };
+    std::vector< char > buffer(20, 'x');
+    auto getObjectFuture = s3.GetObject(
+        "my_bucket",
+        "my_object",
+        buffer.data(),
+        buffer.size()
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto getObject = getObjectFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Completed, getObject.transactionState);
+    EXPECT_EQ(200, getObject.statusCode);
+    EXPECT_EQ(13, getObject.contentSize);
+    EXPECT_TRUE(getObject.content.empty());
+    EXPECT_EQ("Hello, World!xxxxxxx", std::string(buffer.begin(), buffer.end()));
+}
+
+TEST_F(S3Tests, GetObjectIntoBufferTooSmall) {
+    const std::string contents = "Hello, World!";
+    mockClient->responder = [&contents](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        size_t first, last;
+        (void)sscanf(
+            request.headers.GetHeaderValue("Range").c_str(),
+            "bytes=%zu-%zu",
+            &first,
+            &last
+        );
+        last = std::min(last, contents.length() - 1);
+        response.statusCode = 206;
+        response.headers.SetHeader(
+            "Content-Range",
+            "bytes " + std::to_string(first) + "-" + std::to_string(last) + "/13"
+        );
+        response.body = contents.substr(first, last - first + 1);
+        response.state = Http::Response::State::Complete;
+    };
+    std::vector< char > buffer(5, 'x');
+    auto getObjectFuture = s3.GetObject(
+        "my_bucket",
+        "my_object",
+        buffer.data(),
+        buffer.size()
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto getObject = getObjectFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Broken, getObject.transactionState);
+    EXPECT_EQ(5, getObject.contentSize);
+    EXPECT_EQ("Hello", std::string(buffer.begin(), buffer.end()));
+}
+
+TEST_F(S3Tests, GetObjectRange) {
+    auto requestFuture = mockClient->request.get_future();
+    auto getObjectFuture = s3.GetObjectRange("my_bucket", "my_object", 7, 5);
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("GET", request.method);
+    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object", request.target.GenerateString());
+    EXPECT_EQ("bytes=7-11", request.headers.GetHeaderValue("Range"));
+    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 206;
+    mockClient->transaction->response.headers.SetHeader("Content-Range", "bytes 7-11/13");
+    mockClient->transaction->response.body = "World";
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto getObject = getObjectFuture.get();
+    EXPECT_EQ(206, getObject.statusCode);
+    EXPECT_EQ("World", getObject.content);
+    EXPECT_EQ("bytes 7-11/13", getObject.headers.GetHeaderValue("Content-Range"));
+}
+
+TEST_F(S3Tests, DownloadObjectInParts) {
+    std::string contents(95, 'x');
+    for (size_t i = 0; i < contents.length(); ++i) {
+        contents[i] = (char)('!' + i);
+    }
+    std::mutex mutex;
+    std::set< std::string > ranges;
+    size_t requestsWithoutETag = 0;
+    mockClient->responder = [&contents, &mutex, &ranges, &requestsWithoutETag](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        size_t first, last;
+        const auto range = request.headers.GetHeaderValue("Range");
+        {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            ranges.insert(range);
+            if (request.headers.GetHeaderValue("If-Match") != "\"abc\"") {
+                ++requestsWithoutETag;
+            }
+        }
+        (void)sscanf(range.c_str(), "bytes=%zu-%zu", &first, &last);
+        last = std::min(last, contents.length() - 1);
+        response.statusCode = 206;
+        response.headers.SetHeader("ETag", "\"abc\"");
+        response.headers.SetHeader(
+            "Content-Range",
+            "bytes " + std::to_string(first) + "-" + std::to_string(last)
+            + "/" + std::to_string(contents.length())
+        );
+        response.body = contents.substr(first, last - first + 1);
+        response.state = Http::Response::State::Complete;
+    };
+    std::vector< char > buffer(contents.length());
+    auto downloadFuture = s3.DownloadObject(
+        "my_bucket",
+        "my_object",
+        buffer.data(),
+        buffer.size(),
+        10,
+        3
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        downloadFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto download = downloadFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Completed, download.transactionState);
+    EXPECT_EQ(200, download.statusCode);
+    EXPECT_EQ(contents.length(), download.contentSize);
+    EXPECT_EQ(contents, std::string(buffer.begin(), buffer.end()));
+    EXPECT_EQ(
+        std::set< std::string >({
+            "bytes=0-9",
+            "bytes=10-19",
+            "bytes=20-29",
+            "bytes=30-39",
+            "bytes=40-49",
+            "bytes=50-59",
+            "bytes=60-69",
+            "bytes=70-79",
+            "bytes=80-89",
+            "bytes=90-99",
+        }),
+        ranges
+    );
+    EXPECT_EQ(1, requestsWithoutETag);
+}
+
+TEST_F(S3Tests, DownloadObjectPartFails) {
+    mockClient->responder = [](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        if (request.headers.GetHeaderValue("Range") == "bytes=0-9") {
+            response.statusCode = 206;
+            response.headers.SetHeader("Content-Range", "bytes 0-9/30");
+            response.body = "0123456789";
+        } else {
+            response.statusCode = 412;
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<Error><Code>PreconditionFailed</Code></Error>"
+            );
+        }
+        response.state = Http::Response::State::Complete;
+    };
+    auto downloadFuture = s3.DownloadObject(
+        "my_bucket",
+        "my_object",
+        [](size_t offset, const char* data, size_t size){
+            return true;
+        },
+        10,
+        2
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        downloadFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto download = downloadFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Completed, download.transactionState);
+    EXPECT_EQ(412, download.statusCode);
+    EXPECT_EQ("PreconditionFailed", (std::string)download.errorInfo["Code"]);
+}
+
+TEST_F(S3Tests, DownloadObjectRangeIgnored) {
+    const std::string contents = "The quick brown fox jumps over the lazy dog.";
+    std::mutex mutex;
+    size_t requests = 0;
+    mockClient->responder = [&contents, &mutex, &requests](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            ++requests;
+        }
+        response.statusCode = 200;
+        response.headers.SetHeader("ETag", "\"abc\"");
+        response.body = contents;
+        response.state = Http::Response::State::Complete;
+    };
+    std::vector< char > buffer(contents.length());
+    auto downloadFuture = s3.DownloadObject(
+        "my_bucket",
+        "my_object",
+        buffer.data(),
+        buffer.size(),
+        10,
+        3
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        downloadFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto download = downloadFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Completed, download.transactionState);
+    EXPECT_EQ(200, download.statusCode);
+    EXPECT_EQ(contents.length(), download.contentSize);
+    EXPECT_EQ(contents, std::string(buffer.begin(), buffer.end()));
+    EXPECT_EQ(1, requests);
+}
+
+TEST_F(S3Tests, PutObject) {
+    auto requestFuture = mockClient->request.get_future();
+    auto putObjectFuture = s3.PutObject(
+        "my_bucket",
+        "my_object",
+        "Hello, World!",
+        {
+            {"Cache-Control", "max-age=0"},
+        }
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("PUT", request.method);
+    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object", request.target.GenerateString());
+    EXPECT_TRUE(request.headers.HasHeader("x-amz-date"));
+    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
+    EXPECT_TRUE(request.headers.HasHeader("x-amz-content-sha256"));
+    EXPECT_EQ("max-age=0", request.headers.GetHeaderValue("Cache-Control"));
+    EXPECT_EQ("13", request.headers.GetHeaderValue("Content-Length"));
+    EXPECT_EQ("Hello, World!", request.body);
+    EXPECT_NE(
+        std::future_status::ready,
+        putObjectFuture.wait_for(std::chrono::seconds(0))
+    );
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        putObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto putObject = putObjectFuture.get();
+    EXPECT_EQ(200, putObject.statusCode);
+}
+
+TEST_F(S3Tests, PutObjectFromContentSource) {
+    auto requestFuture = mockClient->request.get_future();
+    const std::string contents = "Hello, World!";
+    size_t contentsRead = 0;
+    auto putObjectFuture = s3.PutObject(
+        "my_bucket",
+        "my_object",
+        [&contents, &contentsRead](char* buffer, size_t bufferSize) {
+            const auto amount = std::min(
+                std::min(bufferSize, (size_t)5),
+                contents.length() - contentsRead
+            );
+            (void)contents.copy(buffer, amount, contentsRead);
+            contentsRead += amount;
+            return amount;
+        },
+        {
+            {"Cache-Control", "max-age=0"},
+        }
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("PUT", request.method);
+    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object", request.target.GenerateString());
+    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
+    EXPECT_EQ(
+        "dffd6021bb2bd5b0af676290809ec3a53191dd81c7f70a4b28688a362182986f",
+        request.headers.GetHeaderValue("x-amz-content-sha256")
+    );
+    EXPECT_EQ("max-age=0", request.headers.GetHeaderValue("Cache-Control"));
+    EXPECT_EQ("13", request.headers.GetHeaderValue("Content-Length"));
+    EXPECT_EQ("Hello, World!", request.body);
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        putObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto putObject = putObjectFuture.get();
+    EXPECT_EQ(200, putObject.statusCode);
+}
+
+TEST_F(S3Tests, PutObjectUnsignedPayload) {
+    auto requestFuture = mockClient->request.get_future();
+    auto putObjectFuture = s3.PutObject(
+        "my_bucket",
+        "my_object",
+        "Hello, World!",
+        {},
+        Aws::S3::PayloadSigning::Unsigned
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
+    EXPECT_EQ("UNSIGNED-PAYLOAD", request.headers.GetHeaderValue("x-amz-content-sha256"));
+    EXPECT_EQ("13", request.headers.GetHeaderValue("Content-Length"));
+    EXPECT_EQ("Hello, World!", request.body);
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        putObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto putObject = putObjectFuture.get();
+    EXPECT_EQ(200, putObject.statusCode);
+}
+
+TEST_F(S3Tests, PutObjectStreamingPayload) {
+    auto requestFuture = mockClient->request.get_future();
+    std::string contents(70000, 'x');
+    for (size_t i = 0; i < contents.length(); ++i) {
+        contents[i] = (char)('a' + i % 26);
+    }
+    size_t contentsRead = 0;
+    auto putObjectFuture = s3.PutObject(
+        "my_bucket",
+        "my_object",
+        [&contents, &contentsRead](char* buffer, size_t bufferSize) {
+            const auto amount = std::min(
+                std::min(bufferSize, (size_t)1000),
+                contents.length() - contentsRead
+            );
+            (void)contents.copy(buffer, amount, contentsRead);
+            contentsRead += amount;
+            return amount;
+        },
+        {},
+        contents.length(),
+        Aws::S3::PayloadSigning::Streaming
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
+    EXPECT_EQ(
+        "STREAMING-AWS4-HMAC-SHA256-PAYLOAD",
+        request.headers.GetHeaderValue("x-amz-content-sha256")
+    );
+    EXPECT_EQ("aws-chunked", request.headers.GetHeaderValue("Content-Encoding"));
+    EXPECT_EQ("70000", request.headers.GetHeaderValue("x-amz-decoded-content-length"));
+    EXPECT_EQ(
+        std::to_string(request.body.length()),
+        request.headers.GetHeaderValue("Content-Length")
+    );
+    std::string decoded;
+    std::vector< std::string > chunkSignatures;
+    size_t offset = 0;
+    for (;;) {
+        const auto lineEnd = request.body.find("\r\n", offset);
+        ASSERT_NE(std::string::npos, lineEnd);
+        const auto chunkHeader = request.body.substr(offset, lineEnd - offset);
+        const auto delimiter = chunkHeader.find(";chunk-signature=");
+        ASSERT_NE(std::string::npos, delimiter);
+        const auto chunkSize = (size_t)std::stoul(chunkHeader.substr(0, delimiter), nullptr, 16);
+        chunkSignatures.push_back(chunkHeader.substr(delimiter + 17));
+        EXPECT_EQ(64, chunkSignatures.back().length());
+        offset = lineEnd + 2;
+        decoded += request.body.substr(offset, chunkSize);
+        offset += chunkSize;
+        ASSERT_EQ("\r\n", request.body.substr(offset, 2));
+        offset += 2;
+        if (chunkSize == 0) {
+            break;
+        }
+    }
+    EXPECT_EQ(request.body.length(), offset);
+    EXPECT_EQ(3, chunkSignatures.size());
+    EXPECT_NE(chunkSignatures[0], chunkSignatures[1]);
+    EXPECT_NE(chunkSignatures[1], chunkSignatures[2]);
+    EXPECT_EQ(contents, decoded);
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        putObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto putObject = putObjectFuture.get();
+    EXPECT_EQ(200, putObject.statusCode);
+}
+
+TEST_F(S3Tests, PutObjectStreamingPayloadSourceEndsEarly) {
+    auto requestFuture = mockClient->request.get_future();
+    const std::string contents(1000, 'x');
+    size_t contentsRead = 0;
+    auto putObjectFuture = s3.PutObject(
+        "my_bucket",
+        "my_object",
+        [&contents, &contentsRead](char* buffer, size_t bufferSize) {
+            const auto amount = std::min(bufferSize, contents.length() - contentsRead);
+            (void)contents.copy(buffer, amount, contentsRead);
+            contentsRead += amount;
+            return amount;
+        },
+        {},
+        contents.length() + 1,
+        Aws::S3::PayloadSigning::Streaming
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        putObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto putObject = putObjectFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Broken, putObject.transactionState);
+    EXPECT_EQ(0, putObject.statusCode);
+    EXPECT_EQ(
+        std::future_status::timeout,
+        requestFuture.wait_for(std::chrono::milliseconds(0))
+    );
+}
+
+TEST_F(S3Tests, CreateMultipartUpload) {
+    auto requestFuture = mockClient->request.get_future();
+    auto createFuture = s3.CreateMultipartUpload("my_bucket", "my_object");
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("POST", request.method);
+    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object?uploads", request.target.GenerateString());
+    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.body = (
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+        "<InitiateMultipartUploadResult>"
+            "<Bucket>my_bucket</Bucket>"
+            "<Key>my_object</Key>"
+            "<UploadId>VXBsb2FkIElE</UploadId>"
+        "</InitiateMultipartUploadResult>"
+    );
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        createFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto create = createFuture.get();
+    EXPECT_EQ(200, create.statusCode);
+    EXPECT_EQ("VXBsb2FkIElE", create.uploadId);
+}
+
+TEST_F(S3Tests, UploadPartUploadIdEncoded) {
+    auto requestFuture = mockClient->request.get_future();
+    auto uploadFuture = s3.UploadPart("my_bucket", "my_object", "a+b/c=", 1, "Hello!");
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("PUT", request.method);
+    EXPECT_EQ("partNumber=1&uploadId=a%2Bb%2Fc%3D", request.target.GetQuery());
+    EXPECT_EQ("Hello!", request.body);
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.headers.SetHeader("ETag", "\"etag1\"");
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        uploadFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto upload = uploadFuture.get();
+    EXPECT_EQ(200, upload.statusCode);
+    EXPECT_EQ("\"etag1\"", upload.eTag);
+}
+
+TEST_F(S3Tests, UploadObjectInParts) {
+    // S3 requires every part but the last to be at least 5 MiB, so the
+    // part size asked for here is raised to that.
+    const size_t minPartSize = 5 * 1024 * 1024;
+    std::string contents(2 * minPartSize + 95, 'x');
+    for (size_t i = 0; i < contents.length(); ++i) {
+        contents[i] = (char)('!' + i % 64);
+    }
+    std::mutex mutex;
+    std::map< unsigned int, std::string > parts;
+    std::string completeBody;
+    bool retried = false;
+    mockClient->responder = [&mutex, &parts, &completeBody, &retried](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        std::lock_guard< decltype(mutex) > lock(mutex);
+        const auto query = request.target.GetQuery();
+        unsigned int partNumber;
+        response.statusCode = 200;
+        if (query == "uploads") {
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<InitiateMultipartUploadResult>"
+                    "<UploadId>abc</UploadId>"
+                "</InitiateMultipartUploadResult>"
+            );
+        } else if (sscanf(query.c_str(), "partNumber=%u&uploadId=abc", &partNumber) == 1) {
+            if (
+                (partNumber == 3)
+                && !retried
+            ) {
+                retried = true;
+                response.statusCode = 503;
+            } else {
+                parts[partNumber] = request.body;
+                response.headers.SetHeader(
+                    "ETag",
+                    "\"etag" + std::to_string(partNumber) + "\""
+                );
+            }
+        } else if (query == "uploadId=abc") {
+            completeBody = request.body;
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<CompleteMultipartUploadResult>"
+                    "<ETag>&quot;final&quot;</ETag>"
+                "</CompleteMultipartUploadResult>"
+            );
+        }
+        response.state = Http::Response::State::Complete;
+    };
+    size_t offset = 0;
+    auto uploadFuture = s3.UploadObject(
+        "my_bucket",
+        "my_object",
+        [&contents, &offset](char* buffer, size_t bufferSize){
+            const auto amount = std::min(bufferSize, contents.length() - offset);
+            (void)memcpy(buffer, contents.data() + offset, amount);
+            offset += amount;
+            return amount;
+        },
+        {},
+        10,
+        3
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        uploadFuture.wait_for(std::chrono::milliseconds(5000))
+    );
+    auto upload = uploadFuture.get();
+    EXPECT_EQ(Http::IClient::Transaction::State::Completed, upload.transactionState);
+    EXPECT_EQ(200, upload.statusCode);
+    EXPECT_EQ("\"final\"", upload.eTag);
+    EXPECT_TRUE(retried);
+    ASSERT_EQ(3, parts.size());
+    EXPECT_EQ(minPartSize, parts[1].length());
+    EXPECT_EQ(minPartSize, parts[2].length());
+    EXPECT_EQ(95, parts[3].length());
+    std::string reassembled;
+    std::string expectedCompleteBody = "<CompleteMultipartUpload>";
+    for (const auto& part: parts) {
+        reassembled += part.second;
+        expectedCompleteBody += (
+            "<Part><PartNumber>" + std::to_string(part.first) + "</PartNumber>"
+            + "<ETag>\"etag" + std::to_string(part.first) + "\"</ETag></Part>"
+        );
+    }
+    expectedCompleteBody += "</CompleteMultipartUpload>";
+    EXPECT_EQ(contents, reassembled);
+    EXPECT_EQ(expectedCompleteBody, completeBody);
+}
+
+TEST_F(S3Tests, UploadObjectPartFails) {
+    std::mutex mutex;
+    bool aborted = false;
+    mockClient->responder = [&mutex, &aborted](
+        const Http::Request& request,
+        Http::Response& response
+    ) {
+        std::lock_guard< decltype(mutex) > lock(mutex);
+        const auto query = request.target.GetQuery();
+        if (query == "uploads") {
+            response.statusCode = 200;
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<InitiateMultipartUploadResult>"
+                    "<UploadId>abc</UploadId>"
+                "</InitiateMultipartUploadResult>"
+            );
+        } else if (request.method == "DELETE") {
+            aborted = true;
+            response.statusCode = 204;
+        } else {
+            response.statusCode = 403;
+            response.body = (
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<Error><Code>AccessDenied</Code></Error>"
+            );
+        }
+        response.state = Http::Response::State::Complete;
+    };
+    auto uploadFuture = s3.UploadObject(
+        "my_bucket",
+        "my_object",
+        [](char* buffer, size_t bufferSize){
+            return (size_t)0;
+        }
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        uploadFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto upload = uploadFuture.get();
+    EXPECT_EQ(403, upload.statusCode);
+    EXPECT_EQ("AccessDenied", (std::string)upload.errorInfo["Code"]);
+    std::lock_guard< decltype(mutex) > lock(mutex);
+    EXPECT_TRUE(aborted);
+}
+
+TEST_F(S3Tests, GetObjectWithCompletionDelegate) {
+    auto requestFuture = mockClient->request.get_future();
+    std::promise< Aws::S3::GetObjectResult > getObjectPromise;
+    auto getObjectFuture = getObjectPromise.get_future();
+    s3.GetObject(
+        "my_bucket",
+        "my_object",
+        [&getObjectPromise](Aws::S3::GetObjectResult result){
+            getObjectPromise.set_value(std::move(result));
+        }
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("GET", request.method);
+    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object", request.target.GenerateString());
+    EXPECT_TRUE(request.headers.HasHeader("Authorization"));
+    EXPECT_NE(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.body = "Hello, World!";
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto getObject = getObjectFuture.get();
+    EXPECT_EQ(200, getObject.statusCode);
+    EXPECT_EQ("Hello, World!", getObject.content);
+}
+
+TEST_F(S3Tests, PutObjectWithCompletionDelegate) {
+    auto requestFuture = mockClient->request.get_future();
+    std::promise< Aws::S3::PutObjectResult > putObjectPromise;
+    auto putObjectFuture = putObjectPromise.get_future();
+    s3.PutObject(
+        "my_bucket",
+        "my_object",
+        "Hello, World!",
+        [&putObjectPromise](Aws::S3::PutObjectResult result){
+            putObjectPromise.set_value(std::move(result));
+        },
+        {
+            {"Cache-Control", "max-age=0"},
+        }
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("PUT", request.method);
+    EXPECT_EQ("max-age=0", request.headers.GetHeaderValue("Cache-Control"));
+    EXPECT_EQ("Hello, World!", request.body);
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        putObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto putObject = putObjectFuture.get();
+    EXPECT_EQ(200, putObject.statusCode);
+}
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+namespace {
+
+    /**
+     * This is the return type of a coroutine which runs to completion
+     * without anything waiting for it.
+     */
+    struct DetachedCoroutine {
+        struct promise_type {
+            DetachedCoroutine get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    DetachedCoroutine AwaitGetObject(
+        Aws::S3& s3,
+        std::promise< Aws::S3::GetObjectResult >& getObjectPromise
+    ) {
+        auto result = co_await Aws::GetObjectAsync(s3, "my_bucket", "my_object");
+        getObjectPromise.set_value(std::move(result));
+    }
+
+}
+
+TEST_F(S3Tests, GetObjectAwaitable) {
+    auto requestFuture = mockClient->request.get_future();
+    std::promise< Aws::S3::GetObjectResult > getObjectPromise;
+    auto getObjectFuture = getObjectPromise.get_future();
+    (void)AwaitGetObject(s3, getObjectPromise);
+    ASSERT_EQ(
+        std::future_status::ready,
+        requestFuture.wait_for(std::chrono::milliseconds(100))
+    );
+    auto request = requestFuture.get();
+    EXPECT_EQ("GET", request.method);
+    EXPECT_EQ("//s3.foobar.amazonaws.com:443/my_bucket/my_object", request.target.GenerateString());
+    EXPECT_NE(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::seconds(0))
+    );
+    mockClient->transaction->state = Http::IClient::Transaction::State::Completed;
+    mockClient->transaction->response.statusCode = 200;
+    mockClient->transaction->response.body = "Hello, World!";
+    mockClient->transaction->response.state = Http::Response::State::Complete;
+    mockClient->transaction->Complete();
+    ASSERT_EQ(
+        std::future_status::ready,
+        getObjectFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    auto getObject = getObjectFuture.get();
+    EXPECT_EQ(200, getObject.statusCode);
+    EXPECT_EQ("Hello, World!", getObject.content);
+}
+
+#endif /* __has_include(<coroutine>) */
+#endif /* __cpp_impl_coroutine */
@@ -0,0 +1,105 @@
+/**
+ * @file SigningKeyCacheTests.cpp
+ *
+ * This module contains the unit tests of the
+ * Aws::SigningKeyCache class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <Aws/SignApi.hpp>
+#include <Aws/SigningKeyCache.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::string ToHex(const std::vector< uint8_t >& bytes) {
+        std::string hex;
+        for (auto byte: bytes) {
+            char digits[3];
+            (void)snprintf(digits, sizeof(digits), "%02x", byte);
+            hex += digits;
+        }
+        return hex;
+    }
+
+}
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct SigningKeyCacheTests
+    : public ::testing::Test
+{
+    // Properties
+
+    Aws::SigningKeyCache cache;
+
+    // ::testing::Test
+
+    virtual void SetUp() override {
+    }
+
+    virtual void TearDown() override {
+    }
+};
+
+TEST_F(SigningKeyCacheTests, MakeSigningKeyTestCaseFromDocumentation) {
+    EXPECT_EQ(
+        "c4afb1cc5771d871763a393e44b703571b55cc28424d1a5e86da6ed3c154a4b9",
+        ToHex(
+            Aws::SignApi::MakeSigningKey(
+                "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY",
+                "20150830",
+                "us-east-1",
+                "iam"
+            )
+        )
+    );
+}
+
+TEST_F(SigningKeyCacheTests, GetSigningKeyMatchesDerivedKey) {
+    EXPECT_EQ(
+        Aws::SignApi::MakeSigningKey("secret", "20190303", "us-west-2", "s3"),
+        cache.GetSigningKey("secret", "20190303", "us-west-2", "s3")
+    );
+    EXPECT_EQ(1, cache.GetSize());
+    EXPECT_EQ(
+        Aws::SignApi::MakeSigningKey("secret", "20190303", "us-west-2", "s3"),
+        cache.GetSigningKey("secret", "20190303", "us-west-2", "s3")
+    );
+    EXPECT_EQ(1, cache.GetSize());
+}
+
+TEST_F(SigningKeyCacheTests, DifferentScopesAndSecretsGetDifferentKeys) {
+    const auto key1 = cache.GetSigningKey("secret", "20190303", "us-west-2", "s3");
+    const auto key2 = cache.GetSigningKey("secret", "20190303", "us-east-1", "s3");
+    const auto key3 = cache.GetSigningKey("secret", "20190303", "us-west-2", "iam");
+    const auto key4 = cache.GetSigningKey("other", "20190303", "us-west-2", "s3");
+    EXPECT_NE(key1, key2);
+    EXPECT_NE(key1, key3);
+    EXPECT_NE(key1, key4);
+    EXPECT_EQ(4, cache.GetSize());
+}
+
+TEST_F(SigningKeyCacheTests, KeysForOlderDatesDiscardedAtDayBoundary) {
+    (void)cache.GetSigningKey("secret", "20190303", "us-west-2", "s3");
+    (void)cache.GetSigningKey("secret", "20190303", "us-east-1", "s3");
+    EXPECT_EQ(2, cache.GetSize());
+    EXPECT_EQ(
+        Aws::SignApi::MakeSigningKey("secret", "20190304", "us-west-2", "s3"),
+        cache.GetSigningKey("secret", "20190304", "us-west-2", "s3")
+    );
+    EXPECT_EQ(1, cache.GetSize());
+}
+
+TEST_F(SigningKeyCacheTests, Clear) {
+    (void)cache.GetSigningKey("secret", "20190303", "us-west-2", "s3");
+    cache.Clear();
+    EXPECT_EQ(0, cache.GetSize());
+}
@@ -0,0 +1,120 @@
+/**
+ * @file TimestampProviderTests.cpp
+ *
+ * This module contains the unit tests of the
+ * Aws::TimestampProvider class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <atomic>
+#include <Aws/TimestampProvider.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct TimestampProviderTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the time reported by the clock given to the provider.
+     */
+    std::atomic< time_t > now{1551590536};
+
+    /**
+     * This counts how many times the clock given to the provider is
+     * called.
+     */
+    std::atomic< size_t > clockCalls{0};
+
+    /**
+     * This is the unit under test.
+     */
+    Aws::TimestampProvider provider{
+        [this]{
+            ++clockCalls;
+            return now.load();
+        }
+    };
+
+    // ::testing::Test
+
+    virtual void SetUp() override {
+    }
+
+    virtual void TearDown() override {
+    }
+};
+
+TEST_F(TimestampProviderTests, FormatTimestamp) {
+    EXPECT_EQ("19700101T000000Z", Aws::TimestampProvider::FormatTimestamp(0));
+    EXPECT_EQ("19691231T235959Z", Aws::TimestampProvider::FormatTimestamp(-1));
+    EXPECT_EQ("19720229T120000Z", Aws::TimestampProvider::FormatTimestamp(68212800));
+    EXPECT_EQ("19991231T235959Z", Aws::TimestampProvider::FormatTimestamp(946684799));
+    EXPECT_EQ("20000229T235959Z", Aws::TimestampProvider::FormatTimestamp(951868799));
+    EXPECT_EQ("20000301T000000Z", Aws::TimestampProvider::FormatTimestamp(951868800));
+    EXPECT_EQ("20150830T123600Z", Aws::TimestampProvider::FormatTimestamp(1440938160));
+    EXPECT_EQ("20190303T052216Z", Aws::TimestampProvider::FormatTimestamp(1551590536));
+    EXPECT_EQ("20380119T031407Z", Aws::TimestampProvider::FormatTimestamp(2147483647));
+}
+
+TEST_F(TimestampProviderTests, GetTimestampUsesGivenClock) {
+    EXPECT_EQ("20190303T052216Z", provider.GetTimestamp());
+    EXPECT_EQ(1, clockCalls);
+    EXPECT_EQ("20190303T052216Z", provider.GetTimestamp());
+    EXPECT_EQ(2, clockCalls);
+    now = 1551590537;
+    EXPECT_EQ("20190303T052217Z", provider.GetTimestamp());
+    now = 1440938160;
+    EXPECT_EQ("20150830T123600Z", provider.GetTimestamp());
+    now = 1551590537;
+    EXPECT_EQ("20190303T052217Z", provider.GetTimestamp());
+}
+
+TEST_F(TimestampProviderTests, GetTimestampUsesSystemClockByDefault) {
+    Aws::TimestampProvider systemProvider;
+    const auto before = time(NULL);
+    const auto timestamp = systemProvider.GetTimestamp();
+    const auto after = time(NULL);
+    EXPECT_TRUE(
+        (timestamp == Aws::TimestampProvider::FormatTimestamp(before))
+        || (timestamp == Aws::TimestampProvider::FormatTimestamp(after))
+    ) << timestamp;
+}
+
+TEST_F(TimestampProviderTests, GetTimestampFromManyThreads) {
+    std::atomic< bool > mismatch{false};
+    std::vector< std::thread > threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back(
+            [this, i, &mismatch]{
+                for (int j = 0; j < 10000; ++j) {
+                    if (i == 0) {
+                        ++now;
+                    }
+                    const auto before = now.load();
+                    const auto timestamp = provider.GetTimestamp();
+                    const auto after = now.load();
+                    if (
+                        (timestamp < Aws::TimestampProvider::FormatTimestamp(before))
+                        || (timestamp > Aws::TimestampProvider::FormatTimestamp(after))
+                    ) {
+                        mismatch = true;
+                    }
+                }
+            }
+        );
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(mismatch);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file WorkerPoolTests.cpp
+ *
+ * This module contains the unit tests of the
+ * Aws::WorkerPool class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <atomic>
+#include <Aws/WorkerPool.hpp>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+TEST(WorkerPoolTests, RunPostedTask) {
+    Aws::WorkerPool workerPool(1);
+    std::promise< std::thread::id > ran;
+    auto ranFuture = ran.get_future();
+    workerPool.Post([&ran]{ ran.set_value(std::this_thread::get_id()); });
+    ASSERT_EQ(
+        std::future_status::ready,
+        ranFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    EXPECT_NE(std::this_thread::get_id(), ranFuture.get());
+}
+
+TEST(WorkerPoolTests, NumberOfThreadsIsBounded) {
+    std::mutex mutex;
+    std::set< std::thread::id > threadIds;
+    {
+        Aws::WorkerPool workerPool(2);
+        EXPECT_EQ(2, workerPool.GetSize());
+        for (size_t i = 0; i < 100; ++i) {
+            workerPool.Post(
+                [&mutex, &threadIds]{
+                    std::lock_guard< decltype(mutex) > lock(mutex);
+                    (void)threadIds.insert(std::this_thread::get_id());
+                }
+            );
+        }
+    }
+    EXPECT_GE(2, threadIds.size());
+    EXPECT_LE(1, threadIds.size());
+}
+
+TEST(WorkerPoolTests, AtLeastOneWorker) {
+    Aws::WorkerPool workerPool(0);
+    EXPECT_EQ(1, workerPool.GetSize());
+}
+
+TEST(WorkerPoolTests, WaitingTasksRunBeforeDestruction) {
+    std::atomic< size_t > tasksRun(0);
+    {
+        Aws::WorkerPool workerPool(1);
+        for (size_t i = 0; i < 10; ++i) {
+            workerPool.Post(
+                [&tasksRun]{
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    ++tasksRun;
+                }
+            );
+        }
+    }
+    EXPECT_EQ(10, tasksRun);
+}
+
+TEST(WorkerPoolTests, DestroyFromOwnTask) {
+    auto workerPool = std::make_shared< Aws::WorkerPool >(2);
+    std::promise< void > destroyed;
+    auto destroyedFuture = destroyed.get_future();
+    workerPool->Post(
+        [&workerPool, &destroyed]{
+            workerPool = nullptr;
+            destroyed.set_value();
+        }
+    );
+    EXPECT_EQ(
+        std::future_status::ready,
+        destroyedFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+}
+
+TEST(WorkerPoolTests, DelayedTaskRunsAfterDelay) {
+    Aws::WorkerPool workerPool(1);
+    std::promise< void > delayedRan;
+    std::promise< void > otherRan;
+    auto delayedRanFuture = delayedRan.get_future();
+    auto otherRanFuture = otherRan.get_future();
+    const auto posted = std::chrono::steady_clock::now();
+    workerPool.PostDelayed(
+        [&delayedRan]{ delayedRan.set_value(); },
+        std::chrono::milliseconds(50)
+    );
+    workerPool.Post([&otherRan]{ otherRan.set_value(); });
+    ASSERT_EQ(
+        std::future_status::ready,
+        otherRanFuture.wait_for(std::chrono::milliseconds(40))
+    );
+    EXPECT_EQ(
+        std::future_status::timeout,
+        delayedRanFuture.wait_for(std::chrono::milliseconds(0))
+    );
+    ASSERT_EQ(
+        std::future_status::ready,
+        delayedRanFuture.wait_for(std::chrono::milliseconds(1000))
+    );
+    EXPECT_GE(
+        std::chrono::steady_clock::now() - posted,
+        std::chrono::milliseconds(50)
+    );
+}
+
+TEST(WorkerPoolTests, DelayedTasksRunBeforeDestruction) {
+    std::atomic< size_t > tasksRun(0);
+    {
+        Aws::WorkerPool workerPool(1);
+        workerPool.PostDelayed(
+            [&tasksRun]{ ++tasksRun; },
+            std::chrono::hours(1)
+        );
+    }
+    EXPECT_EQ(1, tasksRun);
+}
@@ -0,0 +1,257 @@
+/**
+ * @file XmlParserTests.cpp
+ *
+ * This module contains the unit tests of the
+ * Aws::XmlParser class.
+ *
+ * © 2019 by Richard Walters
+ */
+
+#include <gtest/gtest.h>
+#include <src/XmlParser.hpp>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * This is a handler which records the events reported by the parser
+     * as strings.
+     */
+    struct RecordingHandler
+        : public Aws::XmlParser::Handler
+    {
+        // Properties
+
+        std::vector< std::string > events;
+
+        // Aws::XmlParser::Handler
+
+        virtual void StartElement(const char* name, size_t nameLength) override {
+            events.push_back("start " + std::string(name, nameLength));
+        }
+
+        virtual void Attribute(
+            const char* name,
+            size_t nameLength,
+            const char* value,
+            size_t valueLength
+        ) override {
+            events.push_back(
+                "attribute " + std::string(name, nameLength)
+                + "=" + std::string(value, valueLength)
+            );
+        }
+
+        virtual void Text(const char* text, size_t length) override {
+            events.push_back("text " + std::string(text, length));
+        }
+
+        virtual void EndElement(const char* name, size_t nameLength) override {
+            events.push_back("end " + std::string(name, nameLength));
+        }
+    };
+
+}
+
+TEST(XmlParserTests, ElementsAndText) {
+    RecordingHandler handler;
+    Aws::XmlParser parser(handler);
+    ASSERT_TRUE(
+        parser.Parse(
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<Result><Name>my_bucket</Name><Contents><Key>a</Key></Contents></Result>"
+        )
+    );
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "start Result",
+            "start Name",
+            "text my_bucket",
+            "end Name",
+            "start Contents",
+            "start Key",
+            "text a",
+            "end Key",
+            "end Contents",
+            "end Result",
+        }),
+        handler.events
+    );
+}
+
+TEST(XmlParserTests, Attributes) {
+    RecordingHandler handler;
+    Aws::XmlParser parser(handler);
+    ASSERT_TRUE(
+        parser.Parse(
+            "<Result xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\" a = 'x>y' b=\"&lt;\"></Result>"
+        )
+    );
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "start Result",
+            "attribute xmlns=http://s3.amazonaws.com/doc/2006-03-01/",
+            "attribute a=x>y",
+            "attribute b=<",
+            "end Result",
+        }),
+        handler.events
+    );
+}
+
+TEST(XmlParserTests, EmptyElement) {
+    RecordingHandler handler;
+    Aws::XmlParser parser(handler);
+    ASSERT_TRUE(parser.Parse("<Result><Prefix/><Owner id=\"1\" /></Result>"));
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "start Result",
+            "start Prefix",
+            "end Prefix",
+            "start Owner",
+            "attribute id=1",
+            "end Owner",
+            "end Result",
+        }),
+        handler.events
+    );
+}
+
+TEST(XmlParserTests, References) {
+    RecordingHandler handler;
+    Aws::XmlParser parser(handler);
+    ASSERT_TRUE(
+        parser.Parse(
+            "<ETag>&quot;abc&quot; &amp; &lt;&gt;&apos; &#65;&#x42;&#xe9; &bogus; &amp</ETag>"
+        )
+    );
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "start ETag",
+            "text \"abc\" & <>' AB\xC3\xA9 &bogus; &amp",
+            "end ETag",
+        }),
+        handler.events
+    );
+}
+
+TEST(XmlParserTests, CommentsInstructionsAndCdata) {
+    RecordingHandler handler;
+    Aws::XmlParser parser(handler);
+    ASSERT_TRUE(
+        parser.Parse(
+            "<?xml version=\"1.0\"?>"
+            "<!DOCTYPE Result>"
+            "<!-- <Ignored> -->"
+            "<Result><![CDATA[<not> &amp; markup]]><?pi <x> ?></Result>"
+        )
+    );
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "start Result",
+            "text <not> &amp; markup",
+            "end Result",
+        }),
+        handler.events
+    );
+}
+
+TEST(XmlParserTests, MalformedDocuments) {
+    const std::vector< std::string > documents{
+        "<Result>",
+        "<Result></Other>",
+        "</Result>",
+        "<Result><Key>a</Result>",
+        "<Result",
+        "<Result a=\"1></Result>",
+        "<Result a></Result>",
+        "<Result><!-- unterminated </Result>",
+        "<>",
+    };
+    for (const auto& document: documents) {
+        RecordingHandler handler;
+        Aws::XmlParser parser(handler);
+        EXPECT_FALSE(parser.Parse(document)) << document;
+    }
+}
+
+TEST(XmlParserTests, DocumentFedInPieces) {
+    const std::string document = (
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<!-- listing -->\n"
+        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+        "<Contents><Key>Tom &amp; Jerry</Key><ETag>&quot;abc&quot;</ETag></Contents>"
+        "<Contents><Key><![CDATA[a<b]]></Key><Size>156</Size></Contents>"
+        "<Prefix/>"
+        "</ListBucketResult>\n"
+    );
+    RecordingHandler wholeHandler;
+    Aws::XmlParser wholeParser(wholeHandler);
+    ASSERT_TRUE(wholeParser.Parse(document));
+
+    // The text of an element may be reported in more than one piece,
+    // so join adjacent pieces of text before comparing events.
+    const auto joinText = [](const std::vector< std::string >& events){
+        std::vector< std::string > joined;
+        for (const auto& event: events) {
+            if (
+                !joined.empty()
+                && (event.substr(0, 5) == "text ")
+                && (joined.back().substr(0, 5) == "text ")
+            ) {
+                joined.back() += event.substr(5);
+            } else {
+                joined.push_back(event);
+            }
+        }
+        return joined;
+    };
+    for (size_t split = 0; split <= document.length(); ++split) {
+        RecordingHandler handler;
+        Aws::XmlParser parser(handler);
+        ASSERT_TRUE(parser.Feed(document.substr(0, split))) << split;
+        ASSERT_TRUE(parser.Feed(document.substr(split))) << split;
+        ASSERT_TRUE(parser.Finish()) << split;
+        EXPECT_EQ(joinText(wholeHandler.events), joinText(handler.events)) << split;
+    }
+    RecordingHandler handler;
+    Aws::XmlParser parser(handler);
+    for (const auto c: document) {
+        ASSERT_TRUE(parser.Feed(&c, 1));
+    }
+    ASSERT_TRUE(parser.Finish());
+    EXPECT_EQ(joinText(wholeHandler.events), joinText(handler.events));
+}
+
+TEST(XmlParserTests, EventsReportedBeforeDocumentComplete) {
+    RecordingHandler handler;
+    Aws::XmlParser parser(handler);
+    ASSERT_TRUE(parser.Feed("<Result><Contents><Key>a</Key></Con"));
+    EXPECT_EQ(
+        std::vector< std::string >({
+            "start Result",
+            "start Contents",
+            "start Key",
+            "text a",
+            "end Key",
+        }),
+        handler.events
+    );
+    ASSERT_TRUE(parser.Feed("tents><Key>b &am"));
+    EXPECT_EQ("text b ", handler.events.back());
+    ASSERT_TRUE(parser.Feed("p; c"));
+    EXPECT_EQ("text & c", handler.events.back());
+    EXPECT_FALSE(parser.Finish());
+}
+
+TEST(XmlParserTests, MalformedPieceDetectedEarly) {
+    RecordingHandler handler;
+    Aws::XmlParser parser(handler);
+    ASSERT_TRUE(parser.Feed("<Result><Key>"));
+    EXPECT_FALSE(parser.Feed("</Other>"));
+    EXPECT_FALSE(parser.Feed("</Result>"));
+    EXPECT_FALSE(parser.Finish());
+    ASSERT_TRUE(parser.Parse("<Result/>"));
+}